@@ -1,5 +1,9 @@
 /* Generic register Device Support */
 
+#if defined __linux__ && !defined _GNU_SOURCE
+#define _GNU_SOURCE /* for pthread_setaffinity_np */
+#endif
+
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
@@ -9,6 +13,7 @@
 #include <callback.h>
 #include <dbAccess.h>
 #include <dbScan.h>
+#include <dbBase.h>
 #include <recSup.h>
 #include <epicsTimer.h>
 #include <epicsMessageQueue.h>
@@ -16,8 +21,18 @@
 #include <cantProceed.h>
 #include <epicsAssert.h>
 #include <epicsExit.h>
+#include <gpHash.h>
 #include <epicsStdioRedirect.h>
 
+#if defined __linux__
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #include "memDisplay.h"
 
 #include "regDevSup.h"
@@ -49,7 +64,109 @@ static epicsMutexId epicsMutexMustCreate() {
 #define epicsMutexUnlock(lock) pthread_mutex_unlock((pthread_mutex_t*)lock);
 #endif
 
+#if EPICSVER >= 31500
+#include <epicsAtomic.h>
+#define regDevReadBarrier() epicsAtomicReadMemoryBarrier()
+#define regDevWriteBarrier() epicsAtomicWriteMemoryBarrier()
+#elif defined __GNUC__ && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define regDevReadBarrier() __sync_synchronize()
+#define regDevWriteBarrier() __sync_synchronize()
+#else
+#define regDevReadBarrier()
+#define regDevWriteBarrier()
+#endif
+
+/* How often a reader retries to get a consistent copy of the block buffer */
+#define BLOCK_READ_RETRIES 1000
+
+#ifndef epicsTimeEventDeviceTime
+#define epicsTimeEventDeviceTime -2
+#endif
+
 static regDeviceNode* registeredDevices = NULL;
+static regDeviceNode* lastRegisteredDevice = NULL;
+/* hash table: name -> device node */
+static struct gphPvt* registeredDevicesTable = NULL;
+
+static regDeviceNode* regDevFindNode(const char* name)
+{
+    GPHENTRY* entry;
+
+    if (!name || !*name || !registeredDevicesTable) return NULL;
+    entry = gphFind(registeredDevicesTable, name, NULL);
+    return entry ? entry->userPvt : NULL;
+}
+
+/* Driver handle -> device node for every call of a driver.
+ * Readers take no lock (also allowed in interrupt context): only
+ * regDevRegisterDevice writes, filling the node before the handle and
+ * publishing a grown table only when complete. Old tables are never freed.
+ */
+struct regDevDriverTable {
+    size_t mask;                       /* size - 1, size is a power of 2 */
+    struct regDevDriverEntry {
+        regDevice* driver;
+        regDeviceNode* device;
+    } entry[1];
+};
+static struct regDevDriverTable* volatile regDevDrivers = NULL;
+static size_t regDevDriverCount = 0;
+
+#define regDevDriverHash(driver) ((((size_t)(driver)) >> 3) * 2654435761U)
+
+static regDeviceNode* regDevLookupDriver(regDevice* driver)
+{
+    struct regDevDriverTable* table = regDevDrivers;
+    size_t i;
+
+    if (!table) return NULL;
+    regDevReadBarrier();
+    for (i = regDevDriverHash(driver) & table->mask; table->entry[i].driver; i = (i + 1) & table->mask)
+    {
+        if (table->entry[i].driver == driver)
+        {
+            regDevReadBarrier();
+            return table->entry[i].device;
+        }
+    }
+    return NULL;
+}
+
+static void regDevDriverTableInsert(struct regDevDriverTable* table, regDevice* driver, regDeviceNode* device)
+{
+    size_t i;
+
+    for (i = regDevDriverHash(driver) & table->mask; table->entry[i].driver; i = (i + 1) & table->mask);
+    table->entry[i].device = device;
+    regDevWriteBarrier();
+    table->entry[i].driver = driver;
+}
+
+static void regDevAddDriver(regDevice* driver, regDeviceNode* device)
+{
+    struct regDevDriverTable* table = regDevDrivers;
+
+    /* first registration of a driver handle wins (as with the former list) */
+    if (regDevLookupDriver(driver)) return;
+    if (!table || 2 * (regDevDriverCount + 1) > table->mask + 1)
+    {
+        /* keep at least half of the table empty for short probes */
+        size_t size = table ? 2 * (table->mask + 1) : 64;
+        struct regDevDriverTable* grown = callocMustSucceed(1,
+            sizeof(struct regDevDriverTable) + (size - 1) * sizeof(struct regDevDriverEntry),
+            "regDevAddDriver");
+        size_t i;
+
+        grown->mask = size - 1;
+        if (table) for (i = 0; i <= table->mask; i++)
+            if (table->entry[i].driver)
+                regDevDriverTableInsert(grown, table->entry[i].driver, table->entry[i].device);
+        regDevWriteBarrier();
+        regDevDrivers = table = grown;
+    }
+    regDevDriverTableInsert(table, driver, device);
+    regDevDriverCount++;
+}
 
 epicsShareDef int regDevDebug = 0;
 epicsExportAddress(int, regDevDebug);
@@ -61,6 +178,32 @@ epicsExportAddress(int, regDevDebug);
         return S_dev_badInit; } \
     assert(priv->magic == MAGIC_PRIV)
 
+/* pin the calling thread to one cpu (if supported by the OS) */
+static int regDevSetCpuAffinity(int cpu)
+{
+#if defined __linux__
+    cpu_set_t cpuset;
+    int status;
+
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    status = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (status != 0)
+    {
+        errlogPrintf("%s: cannot set affinity to cpu %d: %s\n",
+            epicsThreadGetNameSelf(), cpu, strerror(status));
+        return S_dev_badArgument;
+    }
+    regDevDebugLog(DBG_INIT, "%s: running on cpu %d\n",
+        epicsThreadGetNameSelf(), cpu);
+    return S_dev_success;
+#else
+    errlogPrintf("%s: cpu affinity not supported on this system\n",
+        epicsThreadGetNameSelf());
+    return S_dev_badRequest;
+#endif
+}
+
 static int startswith(const unsigned char *s, const char *key)
 {
     int n = 0;
@@ -77,7 +220,7 @@ static int startswith(const unsigned char *s, const char *key)
  * Routine to parse IO arguments
  * IO address line format:
  *
- * <name>:<addr>[:[init]] [T=<type>] [B=<bit>] [I=<invert>] [M=<mask>] [L=<low|strLen>] [H=<high>] [P=<packing>] [F=<feed>] [U=<update>]
+ * <name>:<addr>[:[init]] [T=<type>] [B=<bit>] [I=<invert>] [M=<mask>] [L=<low|strLen>] [H=<high>] [P=<packing>] [F=<feed>] [U=<update>] [D=<deadband>] [W]
  *
  * where: <name>    - symbolic device name
  *        <addr>    - address (byte number) within memory block
@@ -93,6 +236,8 @@ static int startswith(const unsigned char *s, const char *key)
  *        <packing> - number of array values in one fifo register
  *        <feed>    - bytes to the next array element of interlaces arrays
  *        <update>  - milliseconds for periodic update of output records
+ *        <deadband> - largest raw change for which input records keep their value
+ *        W         - write only register: read back from the shadow
  **********************************************************************/
 
 #define epicsInt64T  (98)
@@ -231,18 +376,15 @@ epicsInt64 regDevParseExpr(unsigned char** pp)
     return sum;
 }
 
-int regDevIoParse2(
+static int regDevParseOptions(
     const char* recordName,
-    char* parameterstring,
+    unsigned char* p,
+    char separator,
     regDevPrivate* priv,
-    int types)
+    int types,
+    int* warnings)
 {
-    char devName[255];
-    regDeviceNode* device;
-    unsigned char* p = (unsigned char*)parameterstring;
-    char separator;
     size_t nchar;
-
     static const int maxtype = sizeof(datatypes)/sizeof(*datatypes);
     int type = 0;
     int hset = 0;
@@ -250,156 +392,6 @@ int regDevIoParse2(
     epicsInt64 H = 0;
     epicsInt64 L = 0;
 
-    regDevDebugLog(DBG_INIT, "%s: \"%s\"\n", recordName, parameterstring);
-
-    /* Get rid of leading whitespace and non-alphanumeric chars */
-    while (!isalnum(*p)) if (*p++ == '\0')
-    {
-        errlogPrintf("regDevIoParse %s: no device name in parameter string \"%s\"\n",
-            recordName, parameterstring);
-        return S_dev_badArgument;
-    }
-
-    /* Get device name */
-    nchar = strcspn((char*)p, ":/ ");
-    strncpy(devName, (char*)p, nchar);
-    devName[nchar] = '\0';
-    p += nchar;
-    separator = *p++;
-    regDevDebugLog(DBG_INIT, "%s: device=%s\n",
-        recordName, devName);
-
-    for (device = registeredDevices; device; device = device->next)
-    {
-        if (strcmp(device->name, devName) == 0) break;
-    }
-    if (!device)
-    {
-        errlogPrintf("regDevIoParse %s: device '%s' not found\n",
-            recordName, devName);
-        return S_dev_noDevice;
-    }
-    priv->device = device;
-
-    /* Check device offset (for backward compatibility allow '/') */
-    if (separator == ':' || separator == '/')
-    {
-        ptrdiff_t offset = 0;
-        while (isspace(*p)) p++;
-
-        if (!isdigit(*p))
-        {
-            /* expect record name, maybe in ' quotes, maybe in () */
-            char recName[PVNAME_STRINGSZ];
-            int i = 0;
-            char quote = 0;
-            char parenthesis = 0;
-
-            if (*p == '(')
-            {
-                parenthesis = *p++;
-                while (isspace(*p)) p++;
-            }
-            if (*p == '\'') quote = *p++;
-            /* all non-whitespace chars are legal here except quote ', incl + and * */
-            while (*p && !isspace(*p) && *p != quote && i < sizeof(recName)-1) recName[i++] = *p++;
-            if (quote && *p == quote) p++;
-            recName[i] = 0;
-            priv->offsetRecord = mallocMustSucceed(sizeof (struct dbAddr), "regDevIoParse");
-            if (dbNameToAddr(recName, priv->offsetRecord) != S_dev_success)
-            {
-                free(priv->offsetRecord);
-                priv->offsetRecord = NULL;
-                errlogPrintf("regDevIoParse %s: record '%s' not found\n",
-                    recordName, recName);
-                return S_dev_badArgument;
-            }
-            priv->offsetScale = regDevParseProd(&p);
-            if (parenthesis == '(')
-            {
-                ptrdiff_t scale;
-                offset = regDevParseExpr(&p);
-                if (*p == ')')
-                {
-                    p++;
-                    scale = regDevParseProd(&p);
-                    priv->offsetScale *= scale;
-                    offset *= scale;
-                }
-            }
-        }
-
-        offset += regDevParseExpr(&p);
-        if (offset < 0 && !priv->offsetRecord)
-        {
-            errlogPrintf("regDevIoParse %s: offset %" Z "d<0\n",
-                recordName, offset);
-            return S_dev_badArgument;
-        }
-        priv->offset = offset;
-        if (priv->offsetRecord)
-            regDevDebugLog(DBG_INIT,
-                "%s: offset='%s'*%" Z "d+%" Z "d(0x%" Z "x)\n",
-                recordName, priv->offsetRecord->precord->name,
-                priv->offsetScale, priv->offset, priv->offset);
-        else
-            regDevDebugLog(DBG_INIT,
-                "%s: offset=%" Z "d(0x%" Z "x)\n",
-                recordName, priv->offset, priv->offset);
-        separator = *p++;
-    }
-    else
-    {
-        priv->offset = 0;
-    }
-
-    /* Check readback offset (for backward compatibility allow '!' and '/') */
-    if (separator == ':' || separator == '/' || separator == '!')
-    {
-        unsigned char* p1;
-        ptrdiff_t rboffset;
-
-        if (!device->support->read)
-        {
-            errlogPrintf("regDevIoParse %s: can't read back from device without read function\n",
-                recordName);
-            return S_dev_wrongDevice;
-        }
-
-        while (isspace(*p)) p++;
-        p1 = p;
-        rboffset = regDevParseExpr(&p);
-        if (p1 == p)
-        {
-            if (priv->offsetRecord)
-            {
-                errlogPrintf("regDevIoParse %s: cannot read back from variable offset\n",
-                    recordName);
-                return S_dev_badArgument;
-            }
-            priv->rboffset = priv->offset;
-        }
-        else
-        {
-            if (rboffset < 0)
-            {
-                errlogPrintf("regDevIoParse %s: readback offset %" Z "d < 0\n",
-                    recordName, rboffset);
-                return S_dev_badArgument;
-            }
-            priv->rboffset = rboffset;
-        }
-        regDevDebugLog(DBG_INIT,
-            "%s: readback offset=0x%" Z "x\n", recordName, priv->rboffset);
-        separator = *p++;
-    }
-    else
-    {
-        regDevDebugLog(DBG_INIT,
-            "%s: no readback offset\n", recordName);
-        priv->rboffset = DONT_INIT;
-    }
-
     /* set default values for parameters */
     priv->bit = 0;
     priv->L = 0;
@@ -436,6 +428,8 @@ int regDevIoParse2(
             "Farrayfeed",
             "Finterlace",
             "Uupdate",
+            "Ddeadband",
+            "Wwriteonly",
             "Vvector",
             "Vvec",
             "Vivec",
@@ -514,10 +508,24 @@ int regDevIoParse2(
                 if (toupper(*p) == 'T')
                 {
                     p++;
-                    priv->update = -1;
+                    regDevAllocPrivExt(priv)->update = -1;
                 }
                 else
-                    priv->update = (epicsInt32)regDevParseExpr(&p);
+                    regDevAllocPrivExt(priv)->update = (epicsInt32)regDevParseExpr(&p);
+                break;
+            case 'D': /* D=<raw deadband> (input records process only on change) */
+                val = regDevParseExpr(&p);
+                if (val < 0)
+                {
+                    errlogPrintf("regDevIoParse %s: invalid deadband %" Z "d\n",
+                        recordName, val);
+                    return S_dev_badArgument;
+                }
+                regDevAllocPrivExt(priv)->deadbandSet = 1;
+                priv->ext->deadband = (double)val;
+                break;
+            case 'W': /* W (write only: read from shadow) */
+                regDevAllocPrivExt(priv)->writeOnly = 1;
                 break;
             case 'V': /* V=<irq vector> */
                 priv->irqvec = (epicsInt32)regDevParseExpr(&p);
@@ -615,6 +623,7 @@ int regDevIoParse2(
             lset=0;
         default:
             if (lset || hset) {
+                (*warnings)++;
                 errlogPrintf("regDevIoParse %s: %s%s%s makes"
                     " no sense with T=%s. Ignored.\n",
                     recordName,
@@ -635,93 +644,752 @@ int regDevIoParse2(
     regDevDebugLog(DBG_INIT, "%s: I=%#llx\n",       recordName, (long long)priv->invert);
     regDevDebugLog(DBG_INIT, "%s: M=%#llx\n",       recordName, (long long)priv->mask);
     regDevDebugLog(DBG_INIT, "%s: P=%lli\n",        recordName, (long long)priv->fifopacking);
-    regDevDebugLog(DBG_INIT, "%s: U=%lli\n",        recordName, (long long)priv->update);
+    regDevDebugLog(DBG_INIT, "%s: U=%lli\n",        recordName, (long long)(priv->ext ? priv->ext->update : 0));
     regDevDebugLog(DBG_INIT, "%s: V=%lli\n",        recordName, (long long)priv->irqvec);
     regDevDebugLog(DBG_INIT, "%s: F=%llu(%#llx)\n", recordName, (unsigned long long)priv->interlace,
                                                                 (unsigned long long)priv->interlace);
     return S_dev_success;
 }
 
-int regDevIoParse(dbCommon* record, struct link* link, int types)
-{
-    int status;
+/*********  Init profiling ****************************/
 
-    if (link->type != INST_IO)
-    {
-        regDevPrintErr("illegal link field type %s",
-            pamaplinkType[link->type].strvalue);
-        status = S_dev_badInpType;
-    }
-    else
-    {
-        status = regDevIoParse2(record->name,
-            link->value.instio.string,
-            (regDevPrivate*) record->dpvt,
-            types);
-        if (status == S_dev_success) return status;
-        regDevPrintErr("invalid link field \"%s\"",
-            link->value.instio.string);
-    }
-    free(record->dpvt);
-    record->dpvt = NULL;
-    return status;
-}
+/* Set regDevInitProfile before iocInit and print with regDevInitReport */
+epicsShareDef int regDevInitProfile = 0;
+epicsExportAddress(int, regDevInitProfile);
 
-/*********  Diver registration and access ****************************/
+static const char* const regDevInitPhaseNames[REGDEV_INIT_PHASES] =
+    { "parse", "lookup", "alloc", "readback", "updater", "batch" };
 
-int regDevRegisterDevice(const char* name,
-    const regDevSupport* support, regDevice* driver, size_t size)
+struct regDevInitProfileType {
+    struct regDevInitProfileType* next;
+    const char* name;
+    unsigned long records;
+    double seconds[REGDEV_INIT_PHASES];
+};
+
+struct regDevInitProfileRecord {
+    dbCommon* record;
+    regDeviceNode* device;
+    double total;
+    float seconds[REGDEV_INIT_PHASES];
+    int counted;                       /* in records of its type */
+};
+
+static struct regDevInitProfileType* regDevInitProfileTypes = NULL;
+static struct regDevInitProfileRecord* regDevInitProfileRecords = NULL;
+static size_t regDevInitProfileCount = 0;
+static size_t regDevInitProfileCapacity = 0;
+static double regDevLookupSeconds = 0;
+static int regDevInitProfileSorted = 0;
+
+/* record is NULL for device wide phases */
+static void regDevInitProfileAdd(dbCommon* record, regDeviceNode* device, int phase, double seconds)
 {
-    regDeviceNode **pdevice;
+    struct regDevInitProfileRecord* entry;
+    struct regDevInitProfileType* type;
+    const char* typeName;
 
-    regDevDebugLog(DBG_INIT, "%s: support=%p, driver=%p\n",
-        name, support, driver);
-    for (pdevice = &registeredDevices; *pdevice; pdevice = &(*pdevice)->next)
+    if (device) device->initTime[phase] += seconds;
+    if (!record) return;
+
+    /* init of one record is not interrupted by other records */
+    if (!regDevInitProfileCount ||
+        regDevInitProfileRecords[regDevInitProfileCount-1].record != record)
     {
-        if (strcmp((*pdevice)->name, name) == 0)
+        if (regDevInitProfileCount == regDevInitProfileCapacity)
         {
-            errlogPrintf("regDevRegisterDevice %s: device already exists\n",
-                name);
-            return S_dev_multDevice;
+            regDevInitProfileCapacity = regDevInitProfileCapacity ? 2 * regDevInitProfileCapacity : 1024;
+            regDevInitProfileRecords = realloc(regDevInitProfileRecords,
+                regDevInitProfileCapacity * sizeof(struct regDevInitProfileRecord));
+            if (!regDevInitProfileRecords)
+                cantProceed("regDevInitProfileAdd: out of memory\n");
         }
+        entry = &regDevInitProfileRecords[regDevInitProfileCount++];
+        memset(entry, 0, sizeof(struct regDevInitProfileRecord));
+        entry->record = record;
     }
-    *pdevice = (regDeviceNode*) callocMustSucceed(1, sizeof(regDeviceNode), "regDevRegisterDevice");
-    (*pdevice)->magic = MAGIC_NODE;
-    (*pdevice)->name = strdup(name);
-    (*pdevice)->size = size;
-    (*pdevice)->support = support;
-    (*pdevice)->driver = driver;
-    (*pdevice)->accesslock = epicsMutexMustCreate();
-    return S_dev_success;
+    entry = &regDevInitProfileRecords[regDevInitProfileCount-1];
+    if (!entry->device && device)
+    {
+        entry->device = device;
+        device->initRecords++;
+    }
+    entry->total += seconds;
+    entry->seconds[phase] += (float)seconds;
+
+    typeName = ((struct dbRecordType*)record->rdes)->name;
+    for (type = regDevInitProfileTypes; type; type = type->next)
+        if (type->name == typeName) break;
+    if (!type)
+    {
+        type = callocMustSucceed(1, sizeof(struct regDevInitProfileType), "regDevInitProfileAdd");
+        type->name = typeName;
+        type->next = regDevInitProfileTypes;
+        regDevInitProfileTypes = type;
+    }
+    if (!entry->counted)
+    {
+        type->records++;
+        entry->counted = 1;
+    }
+    type->seconds[phase] += seconds;
 }
 
-/* Only for backward compatibility. Don't use! */
-int regDevAsyncRegisterDevice(const char* name,
-    const regDevSupport* support, regDevice* driver)
+static void regDevInitProfilePrint(const char* name, unsigned long records, const double* seconds)
 {
-    return regDevRegisterDevice(name, support, driver, 0);
+    int phase;
+    double total = 0;
+
+    for (phase = 0; phase < REGDEV_INIT_PHASES; phase++)
+        total += seconds[phase];
+    printf(" %-20s %8lu %9.3f", name, records, total);
+    for (phase = 0; phase < REGDEV_INIT_PHASES; phase++)
+        printf(" %9.3f", seconds[phase]);
+    printf("\n");
 }
 
-regDeviceNode* regDevGetDeviceNode(regDevice* driver) {
-    regDeviceNode* device;
-    for (device = registeredDevices; device; device = device->next)
-        if (device->driver == driver) break;
-    assert(device != NULL);
-    assert(device->magic == MAGIC_NODE);
-    return device;
+static int regDevInitProfileCompare(const void* a, const void* b)
+{
+    const struct regDevInitProfileRecord* ea = a;
+    const struct regDevInitProfileRecord* eb = b;
+
+    if (ea->total != eb->total)
+        return ea->total > eb->total ? -1 : 1;
+    return 0;
 }
 
-regDevice* regDevFind(const char* name)
+int regDevInitReport(int slowest)
 {
     regDeviceNode* device;
+    struct regDevInitProfileType* type;
+    int phase;
+    size_t i;
 
-    if (!name || !*name) return NULL;
-    for (device = registeredDevices; device; device = device->next)
+    if (!regDevInitProfile)
     {
-        if (strcmp(name, device->name) == 0)
-            return device->driver;
+        printf("init profiling disabled: set regDevInitProfile before iocInit\n");
+        return S_dev_success;
     }
-    return NULL;
+    printf(" %-20s %8s %9s", "", "records", "total[s]");
+    for (phase = 0; phase < REGDEV_INIT_PHASES; phase++)
+        printf(" %9s", regDevInitPhaseNames[phase]);
+    printf("\nper device:\n");
+    for (device = registeredDevices; device; device = device->next)
+        regDevInitProfilePrint(device->name, device->initRecords, device->initTime);
+    printf("per record type:\n");
+    for (type = regDevInitProfileTypes; type; type = type->next)
+        regDevInitProfilePrint(type->name, type->records, type->seconds);
+    if (slowest <= 0 || !regDevInitProfileCount) return S_dev_success;
+
+    /* sort once, records do not change after init */
+    if (!regDevInitProfileSorted)
+    {
+        qsort(regDevInitProfileRecords, regDevInitProfileCount,
+            sizeof(struct regDevInitProfileRecord), regDevInitProfileCompare);
+        regDevInitProfileSorted = 1;
+    }
+    printf("slowest records:\n");
+    for (i = 0; i < regDevInitProfileCount && i < (size_t)slowest; i++)
+    {
+        struct regDevInitProfileRecord* entry = &regDevInitProfileRecords[i];
+
+        printf(" %-40s %-10s %-16s %9.6f",
+            entry->record->name,
+            ((struct dbRecordType*)entry->record->rdes)->name,
+            entry->device ? entry->device->name : "-",
+            entry->total);
+        for (phase = 0; phase < REGDEV_INIT_PHASES; phase++)
+            if (entry->seconds[phase] > 0)
+                printf(" %s=%.6f", regDevInitPhaseNames[phase], entry->seconds[phase]);
+        printf("\n");
+    }
+    return S_dev_success;
+}
+
+/* Parse cache: Records generated from templates often share the same
+ * options. Memoize the result of parsing the options for a given
+ * options string, record type defaults and allowed types.
+ */
+
+struct regDevParseCacheEntry {
+    struct regDevParseCacheEntry* next;
+    char* key;
+    epicsUInt8 bit;
+    epicsUInt8 dtype;
+    epicsUInt8 dlen;
+    epicsUInt8 fifopacking;
+    epicsInt32 update;
+    epicsInt32 irqvec;
+    int deadbandSet;
+    double deadband;
+    int writeOnly;
+    epicsInt64 L;
+    epicsInt64 H;
+    epicsUInt64 invert;
+    epicsUInt64 mask;
+    ptrdiff_t interlace;
+};
+
+static struct gphPvt* regDevParseCache = NULL;
+static struct regDevParseCacheEntry* regDevParseCacheEntries = NULL;
+static struct {
+    unsigned long links;
+    unsigned long hits;
+    unsigned long entries;
+    double seconds;
+} regDevParseStats;
+
+static void regDevParseCacheFree(void)
+{
+    struct regDevParseCacheEntry* entry;
+
+    if (!regDevParseCache) return;
+    gphFreeMem(regDevParseCache);
+    regDevParseCache = NULL;
+    while ((entry = regDevParseCacheEntries) != NULL)
+    {
+        regDevParseCacheEntries = entry->next;
+        free(entry->key);
+        free(entry);
+    }
+}
+
+static int regDevParseOptionsCached(
+    const char* recordName,
+    unsigned char* p,
+    char separator,
+    regDevPrivate* priv,
+    int types)
+{
+    char keybuffer[256];
+    char* key = keybuffer;
+    size_t keylen;
+    GPHENTRY* hashentry;
+    struct regDevParseCacheEntry* entry;
+    int warnings = 0;
+    int status;
+
+    /* debug output needs the full parser */
+    if (regDevDebug & DBG_INIT)
+        return regDevParseOptions(recordName, p, separator, priv, types, &warnings);
+
+    /* everything the options parser depends on */
+    keylen = strlen((char*)p) + 32;
+    if (keylen > sizeof(keybuffer))
+        key = mallocMustSucceed(keylen, "regDevParseOptionsCached");
+    sprintf(key, "%x %u %u %02x|%s", types, priv->dtype, priv->dlen,
+        (unsigned char)separator, p);
+
+    if (!regDevParseCache)
+        gphInitPvt(&regDevParseCache, 4096);
+    hashentry = gphFind(regDevParseCache, key, NULL);
+    if (hashentry)
+    {
+        entry = hashentry->userPvt;
+        priv->bit = entry->bit;
+        priv->dtype = entry->dtype;
+        priv->dlen = entry->dlen;
+        priv->fifopacking = entry->fifopacking;
+        if (entry->update)
+            regDevAllocPrivExt(priv)->update = entry->update;
+        if (entry->writeOnly)
+            regDevAllocPrivExt(priv)->writeOnly = 1;
+        if (entry->deadbandSet)
+        {
+            regDevAllocPrivExt(priv)->deadbandSet = 1;
+            priv->ext->deadband = entry->deadband;
+        }
+        priv->irqvec = entry->irqvec;
+        priv->L = entry->L;
+        priv->H = entry->H;
+        priv->invert = entry->invert;
+        priv->mask = entry->mask;
+        priv->interlace = entry->interlace;
+        regDevParseStats.hits++;
+        if (key != keybuffer) free(key);
+        return S_dev_success;
+    }
+
+    status = regDevParseOptions(recordName, p, separator, priv, types, &warnings);
+    if (status == S_dev_success && !warnings)
+    {
+        /* do not cache errors or warnings: each record shall report them */
+        entry = callocMustSucceed(1, sizeof(struct regDevParseCacheEntry), "regDevParseOptionsCached");
+        entry->key = key == keybuffer ? strdup(key) : key;
+        key = NULL;
+        entry->bit = priv->bit;
+        entry->dtype = priv->dtype;
+        entry->dlen = priv->dlen;
+        entry->fifopacking = priv->fifopacking;
+        entry->update = priv->ext ? priv->ext->update : 0;
+        entry->deadbandSet = priv->ext ? priv->ext->deadbandSet : 0;
+        entry->writeOnly = priv->ext ? priv->ext->writeOnly : 0;
+        entry->deadband = priv->ext ? priv->ext->deadband : 0.0;
+        entry->irqvec = priv->irqvec;
+        entry->L = priv->L;
+        entry->H = priv->H;
+        entry->invert = priv->invert;
+        entry->mask = priv->mask;
+        entry->interlace = priv->interlace;
+        hashentry = gphAdd(regDevParseCache, entry->key, NULL);
+        assert(hashentry != NULL);
+        hashentry->userPvt = entry;
+        entry->next = regDevParseCacheEntries;
+        regDevParseCacheEntries = entry;
+        regDevParseStats.entries++;
+    }
+    if (key && key != keybuffer) free(key);
+    return status;
+}
+
+int regDevIoParse2(
+    const char* recordName,
+    char* parameterstring,
+    regDevPrivate* priv,
+    int types)
+{
+    char devName[255];
+    regDeviceNode* device;
+    unsigned char* p = (unsigned char*)parameterstring;
+    char separator;
+    size_t nchar;
+    ptrdiff_t index = -1;
+    size_t base = 0;
+    regDevPrivateExt* ext = NULL;
+    epicsTimeStamp lookupStart, lookupEnd;
+    static regDeviceNode* lastDevice = NULL;
+    int status;
+
+    regDevDebugLog(DBG_INIT, "%s: \"%s\"\n", recordName, parameterstring);
+
+    /* Get rid of leading whitespace and non-alphanumeric chars */
+    while (!isalnum(*p)) if (*p++ == '\0')
+    {
+        errlogPrintf("regDevIoParse %s: no device name in parameter string \"%s\"\n",
+            recordName, parameterstring);
+        return S_dev_badArgument;
+    }
+
+    /* Get device name */
+    nchar = strcspn((char*)p, ":/ [");
+    strncpy(devName, (char*)p, nchar);
+    devName[nchar] = '\0';
+    p += nchar;
+    if (*p == '[')
+    {
+        /* member of a device family: name[index] */
+        p++;
+        index = regDevParseExpr(&p);
+        if (*p++ != ']')
+        {
+            errlogPrintf("regDevIoParse %s: missing ] after device index\n",
+                recordName);
+            return S_dev_badArgument;
+        }
+        regDevDebugLog(DBG_INIT, "%s: device=%s index=%" Z "d\n",
+            recordName, devName, index);
+    }
+    else
+        regDevDebugLog(DBG_INIT, "%s: device=%s\n",
+            recordName, devName);
+    separator = *p++;
+
+    /* records of one device are usually loaded together */
+    if (regDevInitProfile) epicsTimeGetCurrent(&lookupStart);
+    if (lastDevice && strcmp(lastDevice->name, devName) == 0)
+        device = lastDevice;
+    else
+        device = lastDevice = regDevFindNode(devName);
+    if (regDevInitProfile)
+    {
+        epicsTimeGetCurrent(&lookupEnd);
+        regDevLookupSeconds = epicsTimeDiffInSeconds(&lookupEnd, &lookupStart);
+    }
+    if (!device)
+    {
+        errlogPrintf("regDevIoParse %s: device '%s' not found\n",
+            recordName, devName);
+        return S_dev_noDevice;
+    }
+    priv->device = device;
+    if (index != -1)
+    {
+        if (!device->familyCount)
+        {
+            errlogPrintf("regDevIoParse %s: device '%s' is not a device family\n",
+                recordName, devName);
+            return S_dev_wrongDevice;
+        }
+        if (index < 0 || (size_t)index >= device->familyCount)
+        {
+            errlogPrintf("regDevIoParse %s: index %" Z "d out of range of device family %s (0-%u)\n",
+                recordName, index, devName, device->familyCount-1);
+            return S_dev_badSignalNumber;
+        }
+        base = index * device->familyStride;
+    }
+
+    /* Check device offset (for backward compatibility allow '/') */
+    if (separator == ':' || separator == '/')
+    {
+        ptrdiff_t offset = 0;
+        while (isspace(*p)) p++;
+
+        if (!isdigit(*p))
+        {
+            /* expect record name, maybe in ' quotes, maybe in () */
+            char recName[PVNAME_STRINGSZ];
+            int i = 0;
+            char quote = 0;
+            char parenthesis = 0;
+
+            if (*p == '(')
+            {
+                parenthesis = *p++;
+                while (isspace(*p)) p++;
+            }
+            if (*p == '\'') quote = *p++;
+            /* all non-whitespace chars are legal here except quote ', incl + and * */
+            while (*p && !isspace(*p) && *p != quote && i < sizeof(recName)-1) recName[i++] = *p++;
+            if (quote && *p == quote) p++;
+            recName[i] = 0;
+            ext = regDevAllocPrivExt(priv);
+            ext->offsetRecord = mallocMustSucceed(sizeof (struct dbAddr), "regDevIoParse");
+            if (dbNameToAddr(recName, ext->offsetRecord) != S_dev_success)
+            {
+                free(ext->offsetRecord);
+                ext->offsetRecord = NULL;
+                errlogPrintf("regDevIoParse %s: record '%s' not found\n",
+                    recordName, recName);
+                return S_dev_badArgument;
+            }
+            ext->offsetScale = regDevParseProd(&p);
+            if (parenthesis == '(')
+            {
+                ptrdiff_t scale;
+                offset = regDevParseExpr(&p);
+                if (*p == ')')
+                {
+                    p++;
+                    scale = regDevParseProd(&p);
+                    ext->offsetScale *= scale;
+                    offset *= scale;
+                }
+            }
+        }
+
+        offset += regDevParseExpr(&p);
+        if (offset < 0 && !(ext && ext->offsetRecord))
+        {
+            errlogPrintf("regDevIoParse %s: offset %" Z "d<0\n",
+                recordName, offset);
+            return S_dev_badArgument;
+        }
+        if (index != -1 && !(ext && ext->offsetRecord) && (size_t)offset >= device->familyStride)
+        {
+            errlogPrintf("regDevIoParse %s: offset 0x%" Z "x out of range of %s[%" Z "d] (0-0x%" Z "x)\n",
+                recordName, offset, devName, index, device->familyStride-1);
+            return S_dev_badSignalNumber;
+        }
+        priv->offset = base + offset;
+        if (ext && ext->offsetRecord)
+            regDevDebugLog(DBG_INIT,
+                "%s: offset='%s'*%" Z "d+%" Z "d(0x%" Z "x)\n",
+                recordName, ext->offsetRecord->precord->name,
+                ext->offsetScale, priv->offset, priv->offset);
+        else
+            regDevDebugLog(DBG_INIT,
+                "%s: offset=%" Z "d(0x%" Z "x)\n",
+                recordName, priv->offset, priv->offset);
+        separator = *p++;
+    }
+    else
+    {
+        priv->offset = base;
+    }
+
+    /* Check readback offset (for backward compatibility allow '!' and '/') */
+    if (separator == ':' || separator == '/' || separator == '!')
+    {
+        unsigned char* p1;
+        ptrdiff_t rboffset;
+
+        if (!device->support->read && !device->shadow)
+        {
+            errlogPrintf("regDevIoParse %s: can't read back from device without read function\n",
+                recordName);
+            return S_dev_wrongDevice;
+        }
+
+        while (isspace(*p)) p++;
+        p1 = p;
+        rboffset = regDevParseExpr(&p);
+        if (p1 == p)
+        {
+            if (priv->ext && priv->ext->offsetRecord)
+            {
+                errlogPrintf("regDevIoParse %s: cannot read back from variable offset\n",
+                    recordName);
+                return S_dev_badArgument;
+            }
+            priv->rboffset = priv->offset;
+        }
+        else
+        {
+            if (rboffset < 0)
+            {
+                errlogPrintf("regDevIoParse %s: readback offset %" Z "d < 0\n",
+                    recordName, rboffset);
+                return S_dev_badArgument;
+            }
+            if (index != -1 && (size_t)rboffset >= device->familyStride)
+            {
+                errlogPrintf("regDevIoParse %s: readback offset 0x%" Z "x out of range of %s[%" Z "d] (0-0x%" Z "x)\n",
+                    recordName, rboffset, devName, index, device->familyStride-1);
+                return S_dev_badSignalNumber;
+            }
+            priv->rboffset = base + rboffset;
+        }
+        regDevDebugLog(DBG_INIT,
+            "%s: readback offset=0x%" Z "x\n", recordName, priv->rboffset);
+        separator = *p++;
+    }
+    else
+    {
+        regDevDebugLog(DBG_INIT,
+            "%s: no readback offset\n", recordName);
+        priv->rboffset = DONT_INIT;
+    }
+
+    status = regDevParseOptionsCached(recordName, p, separator, priv, types);
+    if (status == S_dev_success && priv->ext && priv->ext->writeOnly)
+    {
+        if (!device->shadow)
+        {
+            errlogPrintf("regDevIoParse %s: write only link needs shadow of device %s\n",
+                recordName, device->name);
+            return S_dev_badArgument;
+        }
+        /* nothing to read back before the first write */
+        priv->rboffset = DONT_INIT;
+    }
+    return status;
+}
+
+/*********  Arena allocation of per record data ****************************/
+
+/* Per record data and private record buffers are allocated at init and
+   never freed while the IOC runs. Thus take them from large chunks of
+   their device instead of calling malloc for each of them.
+   Per record data is allocated before the device is known. It is moved
+   into the chunks of the device as soon as the link has been parsed,
+   before device support, drivers or update groups can keep pointers to
+   it, and never moved again. Slots of records that fail later in
+   init_record are reused by the next record of the same device.
+*/
+
+#define REGDEV_ARENA_CHUNK 0x10000
+#define REGDEV_ARENA_ALIGN 16
+
+struct regDevArena {
+    struct regDevArena* next;
+    size_t size;
+    size_t used;
+    size_t objects;
+    char* data;
+};
+
+static int atInit = 1;
+
+static void* regDevArenaGet(struct regDevArena** parena, size_t size)
+{
+    struct regDevArena* arena = *parena;
+    void* ptr;
+
+    size = (size + REGDEV_ARENA_ALIGN - 1) & ~(size_t)(REGDEV_ARENA_ALIGN - 1);
+    if (!arena || arena->used + size > arena->size)
+    {
+        size_t chunk = size > REGDEV_ARENA_CHUNK ? size : REGDEV_ARENA_CHUNK;
+
+        arena = callocMustSucceed(1, sizeof(struct regDevArena), "regDevArenaGet");
+        arena->data = callocMustSucceed(1, chunk, "regDevArenaGet");
+        arena->size = chunk;
+        arena->next = *parena;
+        *parena = arena;
+    }
+    ptr = arena->data + arena->used;
+    arena->used += size;
+    arena->objects++;
+    return ptr;
+}
+
+static int regDevArenaContains(struct regDevArena* arena, void* ptr)
+{
+    for (; arena; arena = arena->next)
+        if ((char*)ptr >= arena->data && (char*)ptr < arena->data + arena->used)
+            return 1;
+    return 0;
+}
+
+void* regDevArenaAlloc(regDeviceNode* device, size_t size)
+{
+    return regDevArenaGet(&device->arena, size);
+}
+
+static void regDevPlacePriv(dbCommon *record)
+{
+    regDevPrivate* priv = record->dpvt;
+    regDeviceNode* device = priv->device;
+    regDevPrivate* placed;
+
+    if (!atInit || !device) return;
+    if (device->freePrivs)
+    {
+        placed = device->freePrivs;
+        device->freePrivs = *(void**)placed;
+    }
+    else
+        placed = regDevArenaGet(&device->arena, sizeof(regDevPrivate));
+    *placed = *priv;
+    free(priv);
+    record->dpvt = placed;
+}
+
+static void regDevFreePriv(dbCommon *record)
+{
+    regDevPrivate* priv = record->dpvt;
+    regDeviceNode* device;
+
+    if (!priv) return;
+    if (priv->ext)
+    {
+        free(priv->ext->offsetRecord);
+        free(priv->ext);
+    }
+    device = priv->device;
+    if (device && regDevArenaContains(device->arena, priv))
+    {
+        /* keep the slot for the next record of this device */
+        *(void**)priv = device->freePrivs;
+        device->freePrivs = priv;
+    }
+    else
+        free(priv);
+    record->dpvt = NULL;
+}
+
+int regDevIoParse(dbCommon* record, struct link* link, int types)
+{
+    int status;
+
+    if (link->type != INST_IO)
+    {
+        regDevPrintErr("illegal link field type %s",
+            pamaplinkType[link->type].strvalue);
+        status = S_dev_badInpType;
+    }
+    else
+    {
+        epicsTimeStamp start, end;
+
+        epicsTimeGetCurrent(&start);
+        status = regDevIoParse2(record->name,
+            link->value.instio.string,
+            (regDevPrivate*) record->dpvt,
+            types);
+        epicsTimeGetCurrent(&end);
+        regDevParseStats.links++;
+        regDevParseStats.seconds += epicsTimeDiffInSeconds(&end, &start);
+        if (regDevInitProfile)
+        {
+            regDeviceNode* device = record->dpvt ? ((regDevPrivate*)record->dpvt)->device : NULL;
+
+            regDevInitProfileAdd(record, device, REGDEV_INIT_LOOKUP, regDevLookupSeconds);
+            regDevInitProfileAdd(record, device, REGDEV_INIT_PARSE,
+                epicsTimeDiffInSeconds(&end, &start) - regDevLookupSeconds);
+            regDevLookupSeconds = 0;
+        }
+        if (status == S_dev_success)
+        {
+            regDevPlacePriv(record);
+            return status;
+        }
+        regDevPrintErr("invalid link field \"%s\"",
+            link->value.instio.string);
+    }
+    regDevFreePriv(record);
+    return status;
+}
+
+/*********  Diver registration and access ****************************/
+
+int regDevRegisterDevice(const char* name,
+    const regDevSupport* support, regDevice* driver, size_t size)
+{
+    regDeviceNode *device;
+    GPHENTRY* entry;
+
+    regDevDebugLog(DBG_INIT, "%s: support=%p, driver=%p\n",
+        name, support, driver);
+    if (!registeredDevicesTable)
+        gphInitPvt(&registeredDevicesTable, 1024);
+    if (regDevFindNode(name))
+    {
+        errlogPrintf("regDevRegisterDevice %s: device already exists\n",
+            name);
+        return S_dev_multDevice;
+    }
+    if (strchr(name, '['))
+        errlogPrintf("regDevRegisterDevice %s: warning: device name contains '[' and cannot be used in links\n",
+            name);
+    device = (regDeviceNode*) callocMustSucceed(1, sizeof(regDeviceNode), "regDevRegisterDevice");
+    device->magic = MAGIC_NODE;
+    device->name = strdup(name);
+    device->size = size;
+    device->support = support;
+    device->driver = driver;
+    device->accesslock = epicsMutexMustCreate();
+    device->stampLock = epicsMutexMustCreate();
+    device->numaNode = -1;
+    device->updateMaxFactor = 1.0;     /* no update backoff unless configured */
+    device->updateBusyFraction = 0.5;
+    device->updateQueueLimit = 0;
+
+    entry = gphAdd(registeredDevicesTable, device->name, NULL);
+    assert(entry != NULL);
+    entry->userPvt = device;
+    regDevAddDriver(driver, device);
+
+    /* keep list in order of registration for reports */
+    if (lastRegisteredDevice)
+        lastRegisteredDevice->next = device;
+    else
+        registeredDevices = device;
+    lastRegisteredDevice = device;
+    return S_dev_success;
+}
+
+/* Only for backward compatibility. Don't use! */
+int regDevAsyncRegisterDevice(const char* name,
+    const regDevSupport* support, regDevice* driver)
+{
+    return regDevRegisterDevice(name, support, driver, 0);
+}
+
+regDeviceNode* regDevGetDeviceNode(regDevice* driver) {
+    regDeviceNode* device = regDevLookupDriver(driver);
+    assert(device != NULL);
+    assert(device->magic == MAGIC_NODE);
+    return device;
+}
+
+regDevice* regDevFind(const char* name)
+{
+    regDeviceNode* device;
+
+    if (!name || !*name) return NULL;
+    device = regDevFindNode(name);
+    return device ? device->driver : NULL;
 }
 
 /* Only for backward compatibility. Don't use! */
@@ -753,6 +1421,377 @@ int regDevUnlock(regDevice* driver)
     return S_dev_success;
 }
 
+/*********  Driver time stamps ****************************************/
+
+/* One slot per user argument (record name or device name),
+ * thus concurrent transfers do not get each other's time stamps.
+ */
+
+#define REGDEV_STAMP_KEY "stamp"
+
+struct regDevStamp {
+    epicsTimeStamp stamp;
+    int valid;
+};
+
+int regDevSetTimestamp(regDevice* driver, const char* user, const epicsTimeStamp* stamp)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+    GPHENTRY* entry;
+    struct regDevStamp* slot;
+
+    if (!device) return S_dev_noDevice;
+    if (!user || !stamp) return S_dev_badArgument;
+    epicsMutexLock(device->stampLock);
+    if (!device->stamps)
+        gphInitPvt(&device->stamps, 256);
+    entry = gphFind(device->stamps, REGDEV_STAMP_KEY, (void*)user);
+    if (!entry)
+    {
+        entry = gphAdd(device->stamps, REGDEV_STAMP_KEY, (void*)user);
+        if (entry)
+            entry->userPvt = calloc(1, sizeof(struct regDevStamp));
+    }
+    slot = entry ? entry->userPvt : NULL;
+    if (slot)
+    {
+        slot->stamp = *stamp;
+        slot->valid = 1;
+    }
+    epicsMutexUnlock(device->stampLock);
+    return slot ? S_dev_success : S_dev_noMemory;
+}
+
+/* get (and consume) the time stamp the driver reported for user, stamp NULL discards */
+static int regDevGetTimestamp(regDeviceNode* device, const char* user, epicsTimeStamp* stamp)
+{
+    GPHENTRY* entry;
+    struct regDevStamp* slot;
+    int found = 0;
+
+    if (!device->stamps) return 0;
+    epicsMutexLock(device->stampLock);
+    entry = gphFind(device->stamps, REGDEV_STAMP_KEY, (void*)user);
+    slot = entry ? entry->userPvt : NULL;
+    if (slot && slot->valid)
+    {
+        if (stamp) *stamp = slot->stamp;
+        slot->valid = 0;
+        found = 1;
+    }
+    epicsMutexUnlock(device->stampLock);
+    return found;
+}
+
+/*********  Rate limited "I/O Intr" scans ******************/
+
+#define REGDEV_SCAN_KEY "scan"
+
+struct regDevScanCoalescer {
+    struct regDevScanCoalescer* next;
+    IOSCANPVT ioscanpvt;
+    struct regDevScanRate* rate;
+    epicsTimerId timer;
+    epicsTimeStamp last;               /* of last scan */
+    int pending;                       /* delayed scan is scheduled */
+    unsigned long requests;
+    unsigned long scans;
+    unsigned long coalesced;
+};
+
+struct regDevScanRate {
+    double window;                     /* minimal time between scans in seconds */
+    epicsMutexId lock;
+    struct gphPvt* table;              /* find coalescer by scan list */
+    struct regDevScanCoalescer* coalescers;
+    epicsTimerQueueId timerQueue;
+};
+
+static void regDevScanDelayed(struct regDevScanCoalescer* coalescer)
+{
+    epicsMutexLock(coalescer->rate->lock);
+    coalescer->pending = 0;
+    epicsTimeGetCurrent(&coalescer->last);
+    coalescer->scans++;
+    epicsMutexUnlock(coalescer->rate->lock);
+    scanIoRequest(coalescer->ioscanpvt);
+}
+
+static void regDevScanIoRequestNode(regDeviceNode* device, IOSCANPVT ioscanpvt)
+{
+    struct regDevScanRate* rate = device->scanRate;
+    struct regDevScanCoalescer* coalescer;
+    GPHENTRY* entry;
+    epicsTimeStamp now;
+    double since;
+
+    if (!rate || !ioscanpvt)
+    {
+        scanIoRequest(ioscanpvt);
+        return;
+    }
+    epicsMutexLock(rate->lock);
+    entry = gphFind(rate->table, REGDEV_SCAN_KEY, ioscanpvt);
+    if (entry)
+        coalescer = entry->userPvt;
+    else
+    {
+        coalescer = calloc(1, sizeof(struct regDevScanCoalescer));
+        if (coalescer)
+            coalescer->timer = epicsTimerQueueCreateTimer(rate->timerQueue,
+                (epicsTimerCallback)regDevScanDelayed, coalescer);
+        if (!coalescer || !coalescer->timer)
+        {
+            /* no rate limit without memory */
+            free(coalescer);
+            epicsMutexUnlock(rate->lock);
+            scanIoRequest(ioscanpvt);
+            return;
+        }
+        coalescer->ioscanpvt = ioscanpvt;
+        coalescer->rate = rate;
+        entry = gphAdd(rate->table, REGDEV_SCAN_KEY, ioscanpvt);
+        assert(entry != NULL);
+        entry->userPvt = coalescer;
+        coalescer->next = rate->coalescers;
+        rate->coalescers = coalescer;
+    }
+    coalescer->requests++;
+    if (coalescer->pending)
+    {
+        /* the scheduled scan will see the new data */
+        coalescer->coalesced++;
+        epicsMutexUnlock(rate->lock);
+        return;
+    }
+    epicsTimeGetCurrent(&now);
+    since = epicsTimeDiffInSeconds(&now, &coalescer->last);
+    if (since >= rate->window || since < 0)
+    {
+        coalescer->last = now;
+        coalescer->scans++;
+        epicsMutexUnlock(rate->lock);
+        scanIoRequest(ioscanpvt);
+        return;
+    }
+    /* too early: scan at end of window */
+    coalescer->pending = 1;
+    epicsTimerStartDelay(coalescer->timer, rate->window - since);
+    epicsMutexUnlock(rate->lock);
+}
+
+int regDevScanIoRequest(regDevice* driver, IOSCANPVT ioscanpvt)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+
+    if (!device)
+        return S_dev_noDevice;
+    regDevScanIoRequestNode(device, ioscanpvt);
+    return S_dev_success;
+}
+
+int regDevScanRate(const char* devName, double window)
+{
+    regDeviceNode* device;
+    struct regDevScanRate* rate;
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (window < 0) window = 0;
+    rate = device->scanRate;
+    if (rate)
+    {
+        epicsMutexLock(rate->lock);
+        rate->window = window;
+        epicsMutexUnlock(rate->lock);
+        return S_dev_success;
+    }
+    rate = callocMustSucceed(1, sizeof(struct regDevScanRate), "regDevScanRate");
+    rate->window = window;
+    rate->lock = epicsMutexMustCreate();
+    gphInitPvt(&rate->table, 256);
+    rate->timerQueue = epicsTimerQueueAllocate(1, epicsThreadPriorityScanHigh);
+    if (!rate->timerQueue)
+    {
+        errlogPrintf("regDevScanRate %s: epicsTimerQueueAllocate failed\n", devName);
+        gphFreeMem(rate->table);
+        epicsMutexDestroy(rate->lock);
+        free(rate);
+        return S_dev_noMemory;
+    }
+    device->scanRate = rate;
+    return S_dev_success;
+}
+
+/*********  Support for "I/O Intr" by address range ******************/
+
+struct regDevIntRange {
+    size_t start;
+    size_t end;                        /* first byte after range */
+    size_t maxEnd;                     /* of this and all previous ranges */
+    IOSCANPVT ioscanpvt;
+};
+
+struct regDevRangeNotify {
+    epicsMutexId lock;
+    struct gphPvt* table;              /* find range by address */
+    struct regDevIntRange* ranges;     /* sorted by start if sorted is set */
+    size_t count;
+    size_t capacity;
+    int sorted;
+    unsigned long notifies;
+    unsigned long scans;
+};
+
+int regDevEnableRangeNotify(regDevice* driver)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+    struct regDevRangeNotify* rangeNotify;
+
+    if (!device)
+        return S_dev_noDevice;
+    if (device->rangeNotify)
+        return S_dev_success;
+    rangeNotify = callocMustSucceed(1, sizeof(struct regDevRangeNotify), "regDevEnableRangeNotify");
+    rangeNotify->lock = epicsMutexMustCreate();
+    gphInitPvt(&rangeNotify->table, 1024);
+    device->rangeNotify = rangeNotify;
+    return S_dev_success;
+}
+
+static IOSCANPVT regDevGetRangeScanPvt(regDeviceNode* device, regDevPrivate* priv)
+{
+    struct regDevRangeNotify* rangeNotify = device->rangeNotify;
+    struct regDevIntRange* range;
+    size_t start, end, nelm;
+    char key[40];
+    GPHENTRY* hashentry;
+    IOSCANPVT ioscanpvt;
+
+    nelm = priv->nelm ? priv->nelm : 1;
+    if (priv->ext && priv->ext->offsetRecord)
+    {
+        /* offset may change at run time */
+        start = 0;
+        end = (size_t)-1;
+    }
+    else if (priv->interlace < 0)
+    {
+        start = priv->offset + priv->interlace * (nelm - 1);
+        end = priv->offset + priv->dlen;
+    }
+    else
+    {
+        start = priv->offset;
+        end = priv->offset + (priv->interlace ? priv->interlace : priv->dlen) * (nelm - 1) + priv->dlen;
+    }
+
+    /* records with the same range share one scan list */
+    sprintf(key, "%" Z "x-%" Z "x", start, end);
+    epicsMutexLock(rangeNotify->lock);
+    hashentry = gphFind(rangeNotify->table, key, NULL);
+    if (hashentry)
+    {
+        ioscanpvt = hashentry->userPvt;
+        epicsMutexUnlock(rangeNotify->lock);
+        return ioscanpvt;
+    }
+    if (rangeNotify->count == rangeNotify->capacity)
+    {
+        rangeNotify->capacity = rangeNotify->capacity ? 2 * rangeNotify->capacity : 64;
+        rangeNotify->ranges = realloc(rangeNotify->ranges,
+            rangeNotify->capacity * sizeof(struct regDevIntRange));
+        if (!rangeNotify->ranges)
+            cantProceed("regDevGetRangeScanPvt: out of memory\n");
+    }
+    range = &rangeNotify->ranges[rangeNotify->count++];
+    range->start = start;
+    range->end = end;
+    scanIoInit(&range->ioscanpvt);
+    ioscanpvt = range->ioscanpvt;
+    hashentry = gphAdd(rangeNotify->table, strdup(key), NULL);
+    assert(hashentry != NULL);
+    hashentry->userPvt = ioscanpvt;
+    /* sorted at next notification */
+    rangeNotify->sorted = 0;
+    epicsMutexUnlock(rangeNotify->lock);
+    regDevDebugLog(DBG_INIT, "%s: new I/O Intr range 0x%" Z "x-0x%" Z "x\n",
+        device->name, start, end - 1);
+    return ioscanpvt;
+}
+
+static int regDevCompareRanges(const void* a, const void* b)
+{
+    const struct regDevIntRange* ra = a;
+    const struct regDevIntRange* rb = b;
+
+    if (ra->start != rb->start)
+        return ra->start < rb->start ? -1 : 1;
+    return ra->end < rb->end ? -1 : ra->end > rb->end;
+}
+
+static void regDevSortRanges(struct regDevRangeNotify* rangeNotify)
+{
+    size_t i, maxEnd = 0;
+
+    qsort(rangeNotify->ranges, rangeNotify->count, sizeof(struct regDevIntRange),
+        regDevCompareRanges);
+    for (i = 0; i < rangeNotify->count; i++)
+    {
+        if (rangeNotify->ranges[i].end > maxEnd)
+            maxEnd = rangeNotify->ranges[i].end;
+        rangeNotify->ranges[i].maxEnd = maxEnd;
+    }
+    rangeNotify->sorted = 1;
+}
+
+int regDevNotifyRange(regDevice* driver, size_t offset, size_t len)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+    struct regDevRangeNotify* rangeNotify;
+    size_t end, lo, hi, mid, i;
+
+    if (!device)
+        return S_dev_noDevice;
+    rangeNotify = device->rangeNotify;
+    if (!rangeNotify)
+        return S_dev_badRequest;
+    end = offset + len;
+    if (end < offset) end = (size_t)-1;
+
+    epicsMutexLock(rangeNotify->lock);
+    if (!rangeNotify->sorted)
+        regDevSortRanges(rangeNotify);
+    rangeNotify->notifies++;
+
+    /* ranges [lo,count) start after the notified range */
+    lo = 0;
+    hi = rangeNotify->count;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (rangeNotify->ranges[mid].start < end)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    /* walk back while any earlier range reaches into the notified range */
+    for (i = lo; i-- > 0 && rangeNotify->ranges[i].maxEnd > offset; )
+    {
+        if (rangeNotify->ranges[i].end > offset)
+        {
+            regDevScanIoRequestNode(device, rangeNotify->ranges[i].ioscanpvt);
+            rangeNotify->scans++;
+        }
+    }
+    epicsMutexUnlock(rangeNotify->lock);
+    return S_dev_success;
+}
+
 /*********  Support for "I/O Intr" for input records ******************/
 
 long regDevGetInIntInfo(int cmd, dbCommon *record, IOSCANPVT *ppvt)
@@ -773,6 +1812,10 @@ long regDevGetInIntInfo(int cmd, dbCommon *record, IOSCANPVT *ppvt)
     {
         *ppvt = device->blockReceived;
     }
+    else if (priv->irqvec == -1 && device->rangeNotify)
+    {
+        *ppvt = regDevGetRangeScanPvt(device, priv);
+    }
     else if (device->support->getInScanPvt)
     {
         epicsMutexLock(device->accesslock);
@@ -844,7 +1887,119 @@ long regDevGetOutIntInfo(int cmd, dbCommon *record, IOSCANPVT *ppvt)
     return S_dev_success;
 }
 
-/*********  Report routine ********************************************/
+/*********  Report routine ********************************************/
+
+struct regDevAcquisition {
+    epicsThreadId tid;
+    epicsEventId trigger;
+    epicsEventId stopped;
+    double period;
+    int cpu;
+    volatile int stop;
+    unsigned long count;
+    unsigned long errors;
+    unsigned long overruns;
+};
+
+struct regDevUpdateRange {
+    size_t offset;
+    epicsUInt8 dlen;
+    size_t nelem;
+    size_t bufferOffset;
+    int status;
+};
+
+struct regDevUpdateGroup {
+    struct regDevUpdateGroup* next;
+    regDeviceNode* device;
+    epicsInt32 period;                 /* msec */
+    double delay;                      /* effective period in seconds */
+    epicsTimerId timer;
+    dbCommon** records;
+    size_t count;
+    size_t capacity;
+    int layoutValid;                   /* all learned transfers are in ranges */
+    struct regDevUpdateRange* ranges;
+    size_t rangeCount;
+    char* buffer;
+    size_t bufferSize;
+    unsigned long cycles;
+    unsigned long transfers;
+    unsigned long errors;
+    unsigned long unchanged;
+    unsigned long backoffs;
+    double serviceTime;                /* of group reads in last cycle in seconds */
+};
+
+
+/* Set regDevWorkStats to measure dispatcher latency for dbior */
+epicsShareDef int regDevWorkStats = 0;
+epicsExportAddress(int, regDevWorkStats);
+
+#if EPICSVER >= 31601
+typedef epicsUInt64 regDevWorkTime;    /* monotonic nanoseconds */
+#define regDevWorkTimeGet(t) (*(t) = epicsMonotonicGet())
+#define regDevWorkTimeDiff(a, b) ((double)(epicsInt64)(*(a) - *(b)) * 1e-9)
+#else
+typedef epicsTimeStamp regDevWorkTime;
+#define regDevWorkTimeGet(t) epicsTimeGetCurrent(t)
+#define regDevWorkTimeDiff(a, b) epicsTimeDiffInSeconds(a, b)
+#endif
+
+struct regDevWorkMsg {
+    unsigned int cmd;
+    size_t offset;
+    epicsUInt8 dlen;
+    size_t nelem;
+    void* buffer;
+    epicsUInt64 mask;
+    regDevTransferComplete callback;
+    dbCommon* record;
+    int timed;                         /* queued is set */
+    regDevWorkTime queued;
+};
+
+struct regDevWorkStats {               /* latency in seconds, protected by statsLock */
+    unsigned long count;
+    double queueMin;                   /* from request to worker thread */
+    double queueMax;
+    double queueSum;
+    double totalMin;                   /* from request to end of processing */
+    double totalMax;
+    double totalSum;
+};
+
+struct regDevShadowWrite {             /* asynchronous write not yet completed */
+    struct regDevShadowWrite* next;
+    const char* user;                  /* completed by this user only */
+    size_t offset;
+    unsigned int dlen;
+    size_t nelem;
+    int masked;
+    epicsUInt64 mask;
+    size_t capacity;
+    char* data;
+};
+
+struct regDevShadow {                  /* protected by accesslock */
+    char* data;
+    epicsUInt8* known;                 /* known bits of each byte of data */
+    struct regDevShadowWrite* pending;
+    struct regDevShadowWrite* unused;
+    unsigned long merges;
+    unsigned long reads;
+};
+
+struct regDevDispatcher {
+    epicsThreadId tid[NUM_CALLBACK_PRIORITIES];
+    epicsMessageQueueId qid[NUM_CALLBACK_PRIORITIES];
+    unsigned int maxEntries;
+    int busyPoll[NUM_CALLBACK_PRIORITIES];      /* worker never sleeps */
+    int cpu[NUM_CALLBACK_PRIORITIES];           /* pin worker or -1 */
+    struct regDevWorkStats stats[NUM_CALLBACK_PRIORITIES];
+    epicsMutexId statsLock;
+};
+
 
 long regDevReport(int level)
 {
@@ -855,6 +2010,10 @@ long regDevReport(int level)
         printf("no registered devices\n");
         return S_dev_success;
     }
+    if (level > 0)
+        printf("parsed %lu links in %.3f s, %lu option cache hits, %lu cache entries\n",
+            regDevParseStats.links, regDevParseStats.seconds,
+            regDevParseStats.hits, regDevParseStats.entries);
     printf("registered devices:\n");
     for (device = registeredDevices; device; device = device->next)
     {
@@ -872,8 +2031,106 @@ long regDevReport(int level)
         else
             printf("unknown");
 
+        if (device->familyCount)
+            printf(" family [%u] * 0x%" Z "x", device->familyCount, device->familyStride);
         if (device->blockBuffer)
             printf(" block@%p", device->blockBuffer);
+        if (device->acquisition && level > 0)
+        {
+            regDevAcquisition* acquisition = device->acquisition;
+            if (acquisition->period > 0)
+                printf(" acquisition %gs", acquisition->period);
+            else
+                printf(" acquisition triggered");
+            printf(" %lu reads %lu errors %lu overruns",
+                acquisition->count, acquisition->errors, acquisition->overruns);
+        }
+        if (device->arena && level > 0)
+        {
+            struct regDevArena* arena;
+            size_t size = 0, used = 0, objects = 0;
+            unsigned int chunks = 0;
+
+            for (arena = device->arena; arena; arena = arena->next)
+            {
+                size += arena->size;
+                used += arena->used;
+                objects += arena->objects;
+                chunks++;
+            }
+            printf(" arena %" Z "u objects %" Z "u/%" Z "u bytes in %u chunks",
+                objects, used, size, chunks);
+        }
+        if (level > 0)
+        {
+            struct regDevUpdateGroup* group;
+
+            if (device->updateThreadCount)
+                printf(" %u update threads", device->updateThreadCount);
+            if (device->scanRate)
+            {
+                struct regDevScanCoalescer* coalescer;
+                unsigned long requests = 0, scans = 0, coalesced = 0;
+
+                epicsMutexLock(device->scanRate->lock);
+                for (coalescer = device->scanRate->coalescers; coalescer; coalescer = coalescer->next)
+                {
+                    requests += coalescer->requests;
+                    scans += coalescer->scans;
+                    coalesced += coalescer->coalesced;
+                }
+                epicsMutexUnlock(device->scanRate->lock);
+                printf(" I/O Intr window %gms: %lu requests %lu scans %lu coalesced",
+                    device->scanRate->window * 1000, requests, scans, coalesced);
+            }
+            if (device->dispatcher)
+            {
+                int prio;
+
+                for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++)
+                {
+                    struct regDevWorkStats stats;
+
+                    epicsMutexLock(device->dispatcher->statsLock);
+                    stats = device->dispatcher->stats[prio];
+                    epicsMutexUnlock(device->dispatcher->statsLock);
+                    if (!stats.count) continue;
+                    printf(" prio %d%s: %lu requests queue %.1f/%.1f/%.1fus total %.1f/%.1f/%.1fus (min/avg/max)",
+                        prio, device->dispatcher->busyPoll[prio] ? " busy-poll" : "", stats.count,
+                        stats.queueMin * 1e6, stats.queueSum / stats.count * 1e6, stats.queueMax * 1e6,
+                        stats.totalMin * 1e6, stats.totalSum / stats.count * 1e6, stats.totalMax * 1e6);
+                }
+            }
+            if (device->shadow)
+            {
+                size_t i, valid = 0;
+
+                epicsMutexLock(device->accesslock);
+                for (i = 0; i < device->size; i++)
+                    if (device->shadow->known[i] == 0xff) valid++;
+                epicsMutexUnlock(device->accesslock);
+                printf(" shadow %" Z "u bytes known %lu merged writes %lu reads",
+                    valid, device->shadow->merges, device->shadow->reads);
+            }
+            if (device->skippedInputs)
+                printf(" %lu unchanged inputs", device->skippedInputs);
+            if (device->rangeNotify)
+                printf(" I/O Intr %" Z "u ranges %lu notifications %lu scans",
+                    device->rangeNotify->count, device->rangeNotify->notifies,
+                    device->rangeNotify->scans);
+
+            for (group = device->updateGroups; group; group = group->next)
+            {
+                if (group->period > 0)
+                    printf(" updates %dms (now %.0fms, %lu backoffs):",
+                        group->period, group->delay * 1000, group->backoffs);
+                else
+                    printf(" triggered updates:");
+                printf(" %" Z "u records %lu cycles %lu transfers %lu errors %lu unchanged %.3fms last group read",
+                    group->count, group->cycles, group->transfers, group->errors, group->unchanged,
+                    group->serviceTime * 1000);
+            }
+        }
         if (device->support && device->support->report)
         {
             printf(" ");
@@ -939,6 +2196,7 @@ regDevPrivate* regDevAllocPriv(dbCommon *record)
     regDevPrivate* priv;
 
     regDevDebugLog(DBG_INIT, "%s\n", record->name);
+    /* moved into the arena of the device by regDevIoParse */
     priv = callocMustSucceed(1, sizeof(regDevPrivate),"regDevAllocPriv");
     priv->magic = MAGIC_PRIV;
     priv->dtype = epicsInt16T;
@@ -948,6 +2206,13 @@ regDevPrivate* regDevAllocPriv(dbCommon *record)
     return priv;
 }
 
+regDevPrivateExt* regDevAllocPrivExt(regDevPrivate* priv)
+{
+    if (!priv->ext)
+        priv->ext = callocMustSucceed(1, sizeof(regDevPrivateExt), "regDevAllocPrivExt");
+    return priv->ext;
+}
+
 int regDevAssertType(dbCommon *record, int allowedTypes)
 {
     unsigned short dtype;
@@ -991,8 +2256,7 @@ int regDevAssertType(dbCommon *record, int allowedTypes)
     }
     regDevPrintErr("illegal data type %s for this record type",
         regDevTypeName(dtype));
-    free(record->dpvt);
-    record->dpvt = NULL;
+    regDevFreePriv(record);
     return S_db_badField;
 }
 
@@ -1047,8 +2311,7 @@ int regDevCheckFTVL(dbCommon* record, int ftvl)
             priv->dlen = 8;
             return S_dev_success;
     }
-    free(record->dpvt);
-    record->dpvt = NULL;
+    regDevFreePriv(record);
     regDevPrintErr("illegal FTVL value %s",
         pamapdbfType[ftvl].strvalue);
     return S_db_badField;
@@ -1151,25 +2414,313 @@ int regDevCheckType(dbCommon* record, int ftvl, int nelm)
     return status;
 }
 
-/*********  Work dispatcher thread ****************************/
+/*********  Block buffer sequence counter ****************************/
 
-struct regDevWorkMsg {
-    unsigned int cmd;
-    size_t offset;
-    epicsUInt8 dlen;
-    size_t nelem;
-    void* buffer;
-    epicsUInt64 mask;
-    regDevTransferComplete callback;
-    dbCommon* record;
-};
+/* Writers to the block buffer call Begin and End with the accesslock held.
+ * Readers do not lock but retry until they got a copy
+ * while the sequence counter was even and did not change.
+ * Asynchronous drivers fill the buffer after the lock has been released,
+ * thus their fills end only in the completion. Meanwhile other writers
+ * may start, so the counter stays odd until the last writer has ended.
+ */
 
-struct regDevDispatcher {
-    epicsThreadId tid[NUM_CALLBACK_PRIORITIES];
-    epicsMessageQueueId qid[NUM_CALLBACK_PRIORITIES];
-    unsigned int maxEntries;
-};
+static void regDevBlockUpdateBegin(regDeviceNode* device)
+{
+    if (device->blockWriters++ == 0)
+    {
+        device->blockSeq++;
+        regDevWriteBarrier();
+    }
+    epicsTimeGetCurrent(&device->blockTime);
+}
+
+static int regDevGetTimestamp(regDeviceNode* device, const char* user, epicsTimeStamp* stamp);
+static int regDevUpdateFromGroup(dbCommon* record, size_t offset, epicsUInt8 dlen, size_t nelem, void* buffer, int* pstatus);
+
+static void regDevBlockUpdateEnd(regDeviceNode* device, const char* user)
+{
+    /* prefer the acquisition time reported by the driver */
+    regDevGetTimestamp(device, user, &device->blockTime);
+    if (--device->blockWriters == 0)
+    {
+        regDevWriteBarrier();
+        device->blockSeq++;
+    }
+}
+
+/*********  Shadow register cache ****************************/
+
+/* are the bits in mask (or all bits) known, or with outside those not in mask */
+static int regDevShadowKnown(struct regDevShadow* shadow, size_t offset, unsigned int dlen,
+    const void* pmask, int outside)
+{
+    unsigned int i;
+
+    for (i = 0; i < dlen; i++)
+    {
+        epicsUInt8 m = pmask ? ((const epicsUInt8*)pmask)[i] : 0xff;
+        if (outside) m = ~m;
+        if ((shadow->known[offset + i] & m) != m) return 0;
+    }
+    return 1;
+}
+
+/* set the bits in mask (or all bits) of each element */
+static void regDevShadowSetBits(char* data, epicsUInt8* known, size_t offset, unsigned int dlen, size_t nelem,
+    const void* buffer, const void* pmask)
+{
+    size_t i;
+
+    for (i = 0; i < dlen * nelem; i++)
+    {
+        epicsUInt8 m = pmask ? ((const epicsUInt8*)pmask)[i % dlen] : 0xff;
+        data[offset + i] = (char)((data[offset + i] & ~m) | (((const char*)buffer)[i] & m));
+        known[offset + i] |= m;
+    }
+}
+
+/* call with accesslock held; data NULL invalidates */
+static void regDevShadowUpdate(regDeviceNode* device, size_t offset, size_t size, const void* data)
+{
+    struct regDevShadow* shadow = device->shadow;
+
+    if (!shadow || offset + size > device->size) return;
+    if (data)
+    {
+        memcpy(shadow->data + offset, data, size);
+        memset(shadow->known + offset, 0xff, size);
+    }
+    else
+        memset(shadow->known + offset, 0, size);
+}
+
+/* does any asynchronous write still in progress touch this range */
+static int regDevShadowPending(struct regDevShadow* shadow, size_t offset, size_t size)
+{
+    struct regDevShadowWrite* w;
+
+    for (w = shadow->pending; w; w = w->next)
+        if (w->offset < offset + size && offset < w->offset + w->dlen * w->nelem)
+            return 1;
+    return 0;
+}
+
+/* call with accesslock held before writing, returns mask to use */
+static void* regDevShadowMerge(regDeviceNode* device, size_t offset, unsigned int dlen, size_t nelem,
+    void* buffer, void* pmask, int inPlace)
+{
+    struct regDevShadow* shadow = device->shadow;
+    char* old;
+
+    /* only the bits not written need to be known
+       and no other write may change them in the meantime */
+    if (!shadow || !pmask || !inPlace || nelem != 1 || offset + dlen > device->size ||
+        !regDevShadowKnown(shadow, offset, dlen, pmask, 1) ||
+        regDevShadowPending(shadow, offset, dlen))
+        return pmask;
+    old = shadow->data + offset;
+    switch (dlen)
+    {
+        case 1:
+            *(epicsUInt8*)buffer = (*(epicsUInt8*)old & ~*(epicsUInt8*)pmask) |
+                (*(epicsUInt8*)buffer & *(epicsUInt8*)pmask);
+            break;
+        case 2:
+            *(epicsUInt16*)buffer = (*(epicsUInt16*)old & ~*(epicsUInt16*)pmask) |
+                (*(epicsUInt16*)buffer & *(epicsUInt16*)pmask);
+            break;
+        case 4:
+            *(epicsUInt32*)buffer = (*(epicsUInt32*)old & ~*(epicsUInt32*)pmask) |
+                (*(epicsUInt32*)buffer & *(epicsUInt32*)pmask);
+            break;
+        case 8:
+            *(epicsUInt64*)buffer = (*(epicsUInt64*)old & ~*(epicsUInt64*)pmask) |
+                (*(epicsUInt64*)buffer & *(epicsUInt64*)pmask);
+            break;
+        default:
+            return pmask;
+    }
+    shadow->merges++;
+    return NULL;
+}
+
+/* call with accesslock held after writing */
+static void regDevShadowWritten(regDeviceNode* device, size_t offset, unsigned int dlen, size_t nelem,
+    const void* buffer, void* pmask, int status, const char* user)
+{
+    struct regDevShadow* shadow = device->shadow;
+
+    if (!shadow || offset + dlen * nelem > device->size) return;
+    if (status == ASYNC_COMPLETION)
+    {
+        /* keep a copy until the user calls regDevShadowCompleted */
+        struct regDevShadowWrite* w = shadow->unused;
+        size_t size = dlen * nelem;
+
+        if (w)
+            shadow->unused = w->next;
+        else
+            w = callocMustSucceed(1, sizeof(struct regDevShadowWrite), "regDevShadowWritten");
+        if (w->capacity < size)
+        {
+            free(w->data);
+            w->data = mallocMustSucceed(size, "regDevShadowWritten");
+            w->capacity = size;
+        }
+        memcpy(w->data, buffer, size);
+        w->user = user;
+        w->offset = offset;
+        w->dlen = dlen;
+        w->nelem = nelem;
+        w->masked = pmask != NULL;
+        if (pmask) memcpy(&w->mask, pmask, dlen);
+        w->next = shadow->pending;
+        shadow->pending = w;
+    }
+    else if (status == S_dev_success)
+    {
+        /* a masked write makes only the written bits known */
+        regDevShadowSetBits(shadow->data, shadow->known, offset, dlen, nelem, buffer, pmask);
+    }
+    else
+        regDevShadowUpdate(device, offset, dlen * nelem, NULL);
+}
+
+/* call with accesslock held when the asynchronous writes of user have finished */
+static void regDevShadowCompleted(regDeviceNode* device, const char* user, int status)
+{
+    struct regDevShadow* shadow = device->shadow;
+    struct regDevShadowWrite** pw;
+    struct regDevShadowWrite* w;
+
+    if (!shadow) return;
+    pw = &shadow->pending;
+    while ((w = *pw) != NULL)
+    {
+        if (w->user != user)
+        {
+            pw = &w->next;
+            continue;
+        }
+        if (status == S_dev_success)
+            regDevShadowSetBits(shadow->data, shadow->known, w->offset, w->dlen, w->nelem,
+                w->data, w->masked ? &w->mask : NULL);
+        else
+            regDevShadowUpdate(device, w->offset, w->dlen * w->nelem, NULL);
+        *pw = w->next;
+        w->next = shadow->unused;
+        shadow->unused = w;
+    }
+}
+
+static int regDevShadowRead(dbCommon* record, size_t offset, epicsUInt8 dlen, size_t nelem, char* buffer)
+{
+    regDevPrivate* priv = record->dpvt;
+    regDeviceNode* device = priv->device;
+    struct regDevShadow* shadow = device->shadow;
+    int status = S_dev_success;
+    epicsUInt64 mask = priv->mask;
+    size_t i;
+
+    /* only the bits in M=mask need to be known */
+    switch (dlen)
+    {
+        case 1:
+            *(epicsUInt8*)&mask = (epicsUInt8)mask;
+            break;
+        case 2:
+            *(epicsUInt16*)&mask = (epicsUInt16)mask;
+            break;
+        case 4:
+            *(epicsUInt32*)&mask = (epicsUInt32)mask;
+            break;
+    }
+    epicsMutexLock(device->accesslock);
+    for (i = 0; i < nelem; i++)
+    {
+        size_t o = offset + (priv->interlace ? i * priv->interlace : i * dlen);
+        if (o + dlen > device->size || !regDevShadowKnown(shadow, o, dlen, priv->mask ? &mask : NULL, 0))
+        {
+            status = S_dev_badRequest;
+            break;
+        }
+        memcpy(buffer + i * dlen, shadow->data + o, dlen);
+    }
+    if (status == S_dev_success) shadow->reads++;
+    epicsMutexUnlock(device->accesslock);
+    regDevDebugLog(DBG_IN, "%s: read from shadow of %s:0x%" Z "x %s\n",
+        record->name, device->name, offset, status ? "not yet written" : "done");
+    return status;
+}
+
+int regDevEnableShadow(regDevice* driver)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+    struct regDevShadow* shadow;
+
+    if (!device)
+        return S_dev_noDevice;
+    if (device->shadow)
+        return S_dev_success;
+    if (!device->size || device->blockModes)
+    {
+        errlogPrintf("regDevEnableShadow %s: only for devices with size and not in block mode\n",
+            device->name);
+        return S_dev_badRequest;
+    }
+    if (interruptAccept)
+    {
+        errlogPrintf("regDevEnableShadow %s: must be called before iocInit\n", device->name);
+        return S_dev_badRequest;
+    }
+    shadow = callocMustSucceed(1, sizeof(struct regDevShadow), "regDevEnableShadow");
+    shadow->data = callocMustSucceed(1, device->size, "regDevEnableShadow");
+    shadow->known = callocMustSucceed(1, device->size, "regDevEnableShadow");
+    device->shadow = shadow;
+    return S_dev_success;
+}
+
+int regDevShadow(const char* devName)
+{
+    regDeviceNode* device;
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    return regDevEnableShadow(device->driver);
+}
 
+/*********  Work dispatcher thread ****************************/
+
+#if defined __GNUC__ && (defined __i386__ || defined __x86_64__)
+#define regDevCpuRelax() __asm__ __volatile__("pause")
+#else
+#define regDevCpuRelax()
+#endif
+
+static void regDevWorkStatsAdd(regDevDispatcher* dispatcher, int prio, struct regDevWorkMsg* msg,
+    regDevWorkTime* received)
+{
+    struct regDevWorkStats* stats = &dispatcher->stats[prio];
+    regDevWorkTime done;
+    double queue, total;
+
+    regDevWorkTimeGet(&done);
+    queue = regDevWorkTimeDiff(received, &msg->queued);
+    total = regDevWorkTimeDiff(&done, &msg->queued);
+    epicsMutexLock(dispatcher->statsLock);
+    if (stats->count == 0 || queue < stats->queueMin) stats->queueMin = queue;
+    if (queue > stats->queueMax) stats->queueMax = queue;
+    if (stats->count == 0 || total < stats->totalMin) stats->totalMin = total;
+    if (total > stats->totalMax) stats->totalMax = total;
+    stats->queueSum += queue;
+    stats->totalSum += total;
+    stats->count++;
+    epicsMutexUnlock(dispatcher->statsLock);
+}
 
 void regDevWorkThread(regDeviceNode* device)
 {
@@ -1196,12 +2747,25 @@ void regDevWorkThread(regDeviceNode* device)
             epicsThreadGetNameSelf(), prio);
         return;
     }
-    regDevDebugLog(DBG_INIT, "%s: prio %d qid=%p\n",
-        epicsThreadGetNameSelf(), prio, dispatcher->qid[prio]);
+    regDevDebugLog(DBG_INIT, "%s: prio %d qid=%p%s\n",
+        epicsThreadGetNameSelf(), prio, dispatcher->qid[prio],
+        dispatcher->busyPoll[prio] ? " busy polling" : "");
+    if (dispatcher->cpu[prio] >= 0)
+        regDevSetCpuAffinity(dispatcher->cpu[prio]);
 
     while (1)
     {
-        epicsMessageQueueReceive(dispatcher->qid[prio], &msg, sizeof(msg));
+        regDevWorkTime received;
+
+        if (dispatcher->busyPoll[prio])
+        {
+            /* spin instead of sleeping to avoid the wakeup latency */
+            while (epicsMessageQueueTryReceive(dispatcher->qid[prio], &msg, sizeof(msg)) < 0)
+                regDevCpuRelax();
+        }
+        else
+            epicsMessageQueueReceive(dispatcher->qid[prio], &msg, sizeof(msg));
+        if (msg.timed) regDevWorkTimeGet(&received);
         switch (msg.cmd)
         {
             case CMD_WRITE:
@@ -1212,8 +2776,15 @@ void regDevWorkThread(regDeviceNode* device)
                     status = support->write(driver, 0, 1, device->size,
                         device->blockBuffer, NULL, prio, NULL, msg.record->name);
                 else
+                {
+                    void* pmask = regDevShadowMerge(device, msg.offset, msg.dlen, msg.nelem,
+                        msg.buffer, msg.mask ? &msg.mask : NULL,
+                        msg.buffer == &((regDevPrivate*)msg.record->dpvt)->data);
                     status = support->write(driver, msg.offset, msg.dlen, msg.nelem,
-                        msg.buffer, msg.mask ? &msg.mask : NULL, prio, NULL, msg.record->name);
+                        msg.buffer, pmask, prio, NULL, msg.record->name);
+                    regDevShadowWritten(device, msg.offset, msg.dlen, msg.nelem,
+                        msg.buffer, pmask, status, msg.record->name);
+                }
                 epicsMutexUnlock(device->accesslock);
                 break;
             case CMD_READ:
@@ -1222,11 +2793,19 @@ void regDevWorkThread(regDeviceNode* device)
                     blockModes & REGDEV_BLOCK_READ ? "block " : "");
                 epicsMutexLock(device->accesslock);
                 if (blockModes & REGDEV_BLOCK_READ)
+                {
+                    regDevBlockUpdateBegin(device);
                     status = support->read(driver, 0, 1, device->size,
                         device->blockBuffer, prio, NULL, msg.record->name);
+                    regDevBlockUpdateEnd(device, msg.record->name);
+                }
                 else
+                {
                     status = support->read(driver, msg.offset, msg.dlen, msg.nelem,
                         msg.buffer, prio, NULL, msg.record->name);
+                    if (status == S_dev_success)
+                        regDevShadowUpdate(device, msg.offset, msg.dlen * msg.nelem, msg.buffer);
+                }
                 epicsMutexUnlock(device->accesslock);
                 break;
             case CMD_EXIT:
@@ -1242,6 +2821,7 @@ void regDevWorkThread(regDeviceNode* device)
                 continue;
         }
         msg.callback(msg.record->name, status);
+        if (msg.timed) regDevWorkStatsAdd(dispatcher, prio, &msg, &received);
     }
 }
 
@@ -1253,6 +2833,7 @@ void regDevWorkExit(regDeviceNode* device)
 
     /* destroying the queue cancels all pending requests and terminates the work threads [not true] */
     msg.cmd = CMD_EXIT;
+    msg.timed = 0;
     for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++)
     {
         if (dispatcher->qid[prio])
@@ -1289,19 +2870,217 @@ int regDevStartWorkQueue(regDeviceNode* device, unsigned int prio)
     return dispatcher->tid[prio] != NULL ? S_dev_success : S_dev_internal;
 }
 
-int regDevInstallWorkQueue(regDevice* driver, unsigned int maxEntries)
+int regDevInstallWorkQueue(regDevice* driver, unsigned int maxEntries)
+{
+    regDeviceNode* device = regDevGetDeviceNode(driver);
+    int prio;
+
+    regDevDebugLog(DBG_INIT, "%s: maxEntries=%u\n", device->name, maxEntries);
+
+    device->dispatcher = callocMustSucceed(1, sizeof(regDevDispatcher), "regDevInstallWorkQueue");
+    device->dispatcher->maxEntries = maxEntries;
+    device->dispatcher->statsLock = epicsMutexMustCreate();
+    for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++)
+        device->dispatcher->cpu[prio] = -1;
+
+    /* actual work queues and threads are created when needed */
+
+    epicsAtExit((void(*)(void*))regDevWorkExit, device);
+    return S_dev_success;
+}
+
+int regDevBusyPoll(const char* devName, int prio, int cpu)
+{
+    regDeviceNode* device;
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (!device->dispatcher)
+    {
+        errlogPrintf("device %s has no work queue\n", devName);
+        return S_dev_badRequest;
+    }
+    if (prio < 0 || prio >= NUM_CALLBACK_PRIORITIES)
+    {
+        errlogPrintf("illegal priority %d\n", prio);
+        return S_dev_badArgument;
+    }
+    if (device->dispatcher->tid[prio])
+    {
+        errlogPrintf("regDevBusyPoll must be called before iocInit\n");
+        return S_dev_badRequest;
+    }
+    if (cpu < 0)
+        errlogPrintf("regDevBusyPoll %s: warning: busy polling without dedicated cpu\n", devName);
+    device->dispatcher->busyPoll[prio] = 1;
+    device->dispatcher->cpu[prio] = cpu;
+    return S_dev_success;
+}
+
+/*********  Hugepage and NUMA buffers ****************************/
+
+struct regDevMapping {
+    struct regDevMapping* next;
+    void* ptr;
+    size_t size;
+};
+
+#if defined __linux__
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+/* from numaif.h, to avoid a dependency on libnuma */
+#define REGDEV_MPOL_BIND 2
+#define REGDEV_MPOL_MF_MOVE (1<<1)
+
+static void* regDevMapBuffer(regDeviceNode* device, const char* name, size_t size)
+{
+    void* ptr = MAP_FAILED;
+    size_t pagesize = sysconf(_SC_PAGESIZE);
+    struct regDevMapping* mapping;
+
+#ifdef MAP_HUGETLB
+    if (device->hugepageSize)
+    {
+        int shift = 0;
+        size_t hugesize = (size + device->hugepageSize - 1) & ~(device->hugepageSize - 1);
+        while (((size_t)1 << shift) < device->hugepageSize) shift++;
+        ptr = mmap(NULL, hugesize, PROT_READ|PROT_WRITE,
+            MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|(shift << MAP_HUGE_SHIFT), -1, 0);
+        if (ptr == MAP_FAILED)
+            errlogPrintf("regDevAllocBuffer %s: no %" Z "u KiB hugepages available: %s\n",
+                name, device->hugepageSize >> 10, strerror(errno));
+        else
+        {
+            pagesize = device->hugepageSize;
+            size = hugesize;
+        }
+    }
+#endif
+    if (ptr == MAP_FAILED)
+    {
+        size = (size + pagesize - 1) & ~(pagesize - 1);
+        ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
+            MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            return NULL;
+#ifdef MADV_HUGEPAGE
+        /* at least try transparent hugepages */
+        if (device->hugepageSize)
+            madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+#ifdef SYS_mbind
+    if (device->numaNode >= 0)
+    {
+        /* must be done before the pages are touched */
+        unsigned long nodemask[4] = {0};
+        if ((size_t)device->numaNode < sizeof(nodemask)*8)
+        {
+            nodemask[device->numaNode / (sizeof(long)*8)] = 1UL << (device->numaNode % (sizeof(long)*8));
+            if (syscall(SYS_mbind, ptr, size, REGDEV_MPOL_BIND, nodemask,
+                    sizeof(nodemask)*8, REGDEV_MPOL_MF_MOVE) != 0)
+                errlogPrintf("regDevAllocBuffer %s: cannot bind memory to NUMA node %d: %s\n",
+                    name, device->numaNode, strerror(errno));
+        }
+    }
+#endif
+    /* locking also faults in all pages */
+    if (mlock(ptr, size) != 0)
+        errlogPrintf("regDevAllocBuffer %s: cannot lock memory: %s\n",
+            name, strerror(errno));
+    mapping = callocMustSucceed(1, sizeof(struct regDevMapping), "regDevMapBuffer");
+    mapping->ptr = ptr;
+    mapping->size = size;
+    mapping->next = device->mappings;
+    device->mappings = mapping;
+    regDevDebugLog(DBG_INIT, "%s: mapped %" Z "u bytes at %p with %" Z "u KiB pages\n",
+        name, size, ptr, pagesize >> 10);
+    return ptr;
+}
+#endif
+
+/* free memory allocated by regDevAllocBuffer without dmaAlloc */
+static void regDevReleaseBuffer(regDeviceNode* device, void* ptr)
 {
-    regDeviceNode* device = regDevGetDeviceNode(driver);
-
-    regDevDebugLog(DBG_INIT, "%s: maxEntries=%u\n", device->name, maxEntries);
+    struct regDevMapping** pmapping;
 
-    device->dispatcher = callocMustSucceed(1, sizeof(regDevDispatcher), "regDevInstallWorkQueue");
-    device->dispatcher->maxEntries = maxEntries;
+    if (!ptr) return;
+    for (pmapping = &device->mappings; *pmapping; pmapping = &(*pmapping)->next)
+    {
+        struct regDevMapping* mapping = *pmapping;
+        if (mapping->ptr == ptr)
+        {
+#if defined __linux__
+            munlock(ptr, mapping->size);
+            munmap(ptr, mapping->size);
+#endif
+            *pmapping = mapping->next;
+            free(mapping);
+            return;
+        }
+    }
+    free(ptr);
+}
 
-    /* actual work queues and threads are created when needed */
+int regDevBufferPolicy(const char* devName, const char* hugepages, const char* numaNode)
+{
+    regDeviceNode* device;
+    size_t pagesize = 0;
+    char* end;
 
-    epicsAtExit((void(*)(void*))regDevWorkExit, device);
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (interruptAccept)
+    {
+        errlogPrintf("regDevBufferPolicy must be called before iocInit\n");
+        return S_dev_badRequest;
+    }
+    if (hugepages && *hugepages)
+    {
+        pagesize = strtoul(hugepages, &end, 0);
+        switch (toupper((unsigned char)*end))
+        {
+            case 'G': pagesize <<= 10; /* fall through */
+            case 'M': pagesize <<= 10; /* fall through */
+            case 'K': pagesize <<= 10; /* fall through */
+            case 0: break;
+            default:
+                errlogPrintf("illegal hugepage size %s\n", hugepages);
+                return S_dev_badArgument;
+        }
+        if (pagesize & (pagesize - 1))
+        {
+            errlogPrintf("hugepage size %s is not a power of 2\n", hugepages);
+            return S_dev_badArgument;
+        }
+    }
+#if defined __linux__
+    device->hugepageSize = pagesize;
+    device->numaNode = numaNode && *numaNode ? strtol(numaNode, NULL, 0) : -1;
+    if (device->dmaAlloc)
+    {
+        errlogPrintf("device %s has a DMA allocator: buffer policy ignored\n", devName);
+        return S_dev_success;
+    }
+    if (device->blockBuffer && device->blockBufferAllocated)
+    {
+        /* block buffer has been allocated already by regDevMakeBlockdevice */
+        return regDevAllocBuffer(device, device->name, (void**)&device->blockBuffer, device->size);
+    }
     return S_dev_success;
+#else
+    errlogPrintf("regDevBufferPolicy not supported on this system\n");
+    return S_dev_badRequest;
+#endif
 }
 
 /*********  DMA buffers ****************************/
@@ -1323,6 +3102,11 @@ int regDevAllocBuffer(regDeviceNode* device, const char* name, void** bptr, size
         *bptr = ptr;
         return S_dev_success;
     }
+#if defined __linux__
+    if (device->hugepageSize || device->numaNode >= 0)
+        ptr = regDevMapBuffer(device, name, size);
+    else
+#endif
     ptr = (char *)calloc(1, size);
     if (ptr == NULL)
     {
@@ -1331,7 +3115,7 @@ int regDevAllocBuffer(regDeviceNode* device, const char* name, void** bptr, size
             name);
         return S_dev_noMemory;
     }
-    free (*bptr);
+    regDevReleaseBuffer(device, *bptr);
     *bptr = ptr;
     return S_dev_success;
 }
@@ -1339,11 +3123,20 @@ int regDevAllocBuffer(regDeviceNode* device, const char* name, void** bptr, size
 int regDevMemAlloc(dbCommon* record, void** bptr, size_t size)
 {
     regDeviceNode* device;
+    int status;
+    epicsTimeStamp start, end;
 
     regDevGetPriv();
     device = priv->device;
     assert(device != NULL);
-    return regDevAllocBuffer(device, record->name, bptr, size);
+    if (regDevInitProfile) epicsTimeGetCurrent(&start);
+    status = regDevAllocBuffer(device, record->name, bptr, size);
+    if (regDevInitProfile && atInit)
+    {
+        epicsTimeGetCurrent(&end);
+        regDevInitProfileAdd(record, device, REGDEV_INIT_ALLOC, epicsTimeDiffInSeconds(&end, &start));
+    }
+    return status;
 }
 
 int regDevMakeBlockdevice(regDevice* driver, unsigned int modes, int swap, void* buffer)
@@ -1359,6 +3152,7 @@ int regDevMakeBlockdevice(regDevice* driver, unsigned int modes, int swap, void*
             status = regDevAllocBuffer(device, device->name, (void**)&device->blockBuffer, device->size);
             if (status != S_dev_success)
                 return status;
+            device->blockBufferAllocated = 1;
         }
         if (modes & REGDEV_BLOCK_READ)
             scanIoInit(&device->blockReceived);
@@ -1370,13 +3164,436 @@ int regDevMakeBlockdevice(regDevice* driver, unsigned int modes, int swap, void*
     return S_dev_success;
 }
 
-static int atInit = 1;
+int regDevMakeFamily(regDevice* driver, unsigned int count, size_t stride)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+
+    if (!device)
+        return S_dev_noDevice;
+    if (!count || !stride || (device->size && count * stride > device->size))
+    {
+        errlogPrintf("regDevMakeFamily %s: %u members of 0x%" Z "x bytes do not fit into device size 0x%" Z "x\n",
+            device->name, count, stride, device->size);
+        return S_dev_badArgument;
+    }
+    device->familyCount = count;
+    device->familyStride = stride;
+    return S_dev_success;
+}
+
+/*********  Block acquisition thread ****************************/
+
+static void regDevAcquisitionThread(regDeviceNode* device)
+{
+    regDevAcquisition* acquisition = device->acquisition;
+    epicsTimeStamp next, now;
+    double delay;
+    int status;
+
+    if (acquisition->cpu >= 0)
+        regDevSetCpuAffinity(acquisition->cpu);
+    regDevDebugLog(DBG_INIT, "%s: acquisition thread \"%s\" starting with period %g s\n",
+        device->name, epicsThreadGetNameSelf(), acquisition->period);
+
+    epicsTimeGetCurrent(&next);
+    while (!acquisition->stop)
+    {
+        if (acquisition->period > 0)
+        {
+            /* schedule relative to the last planned start to avoid drift */
+            epicsTimeAddSeconds(&next, acquisition->period);
+            epicsTimeGetCurrent(&now);
+            delay = epicsTimeDiffInSeconds(&next, &now);
+            if (delay > 0)
+                epicsEventWaitWithTimeout(acquisition->trigger, delay);
+            else
+            {
+                acquisition->overruns++;
+                next = now;
+            }
+        }
+        else
+            epicsEventMustWait(acquisition->trigger);
+        if (acquisition->stop) break;
+
+        epicsMutexLock(device->accesslock);
+        regDevBlockUpdateBegin(device);
+        status = device->support->read(device->driver, 0, 1, device->size,
+            device->blockBuffer, 2, NULL, device->name);
+        regDevBlockUpdateEnd(device, device->name);
+        epicsMutexUnlock(device->accesslock);
+        if (status != S_dev_success)
+        {
+            if (acquisition->errors++ == 0)
+                errlogPrintf("%s: block read failed with status 0x%x\n",
+                    device->name, status);
+            continue;
+        }
+        acquisition->count++;
+        regDevScanIoRequestNode(device, device->blockReceived);
+    }
+    regDevDebugLog(DBG_INIT, "%s: acquisition stopped\n", device->name);
+    epicsEventSignal(acquisition->stopped);
+}
+
+static void regDevAcquisitionExit(regDeviceNode* device)
+{
+    regDevAcquisition* acquisition = device->acquisition;
+
+    acquisition->stop = 1;
+    epicsEventSignal(acquisition->trigger);
+    epicsEventWaitWithTimeout(acquisition->stopped, 5.0);
+}
+
+int regDevStartAcquisition(const char* devName, double period, int priority, int cpu)
+{
+    regDeviceNode* device;
+    regDevAcquisition* acquisition;
+    char threadName[32];
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (!(device->blockModes & REGDEV_BLOCK_READ) || !device->support->read)
+    {
+        errlogPrintf("device %s is no readable block device\n", devName);
+        return S_dev_badRequest;
+    }
+    if (device->acquisition)
+    {
+        errlogPrintf("device %s already has an acquisition thread\n", devName);
+        return S_dev_multDevice;
+    }
+    if (period < 0) period = 0;
+    if (priority <= 0 || priority > epicsThreadPriorityMax)
+        priority = epicsThreadPriorityHigh;
+
+    acquisition = callocMustSucceed(1, sizeof(regDevAcquisition), "regDevStartAcquisition");
+    acquisition->trigger = epicsEventMustCreate(epicsEventEmpty);
+    acquisition->stopped = epicsEventMustCreate(epicsEventEmpty);
+    acquisition->period = period;
+    acquisition->cpu = cpu;
+    device->acquisition = acquisition;
+
+    epicsSnprintf(threadName, sizeof(threadName), "%s-acq", device->name);
+    acquisition->tid = epicsThreadCreate(threadName, priority,
+        epicsThreadGetStackSize(epicsThreadStackSmall),
+        (EPICSTHREADFUNC) regDevAcquisitionThread, device);
+    if (!acquisition->tid)
+    {
+        errlogPrintf("%s: cannot start acquisition thread\n", devName);
+        device->acquisition = NULL;
+        epicsEventDestroy(acquisition->trigger);
+        epicsEventDestroy(acquisition->stopped);
+        free(acquisition);
+        return S_dev_internal;
+    }
+    epicsAtExit((void(*)(void*))regDevAcquisitionExit, device);
+    return S_dev_success;
+}
+
+int regDevTriggerAcquisition(regDevice* driver)
+{
+    regDeviceNode* device = regDevLookupDriver(driver);
+
+    if (!device) return S_dev_noDevice;
+    if (!device->acquisition) return S_dev_badRequest;
+    epicsEventSignal(device->acquisition->trigger);
+    return S_dev_success;
+}
+
+/*********  Batched readback at init ****************************/
+
+/* When enabled, readbacks of output records during init_record are not
+ * read from the device immediately. Instead they are collected per device
+ * and read in a few large transfers when device support init has finished.
+ * Then the update function of each record distributes the values.
+ * Until then, regDevRead returns ASYNC_COMPLETION, the record does not
+ * convert and stays undefined.
+ */
+
+epicsShareDef int regDevBatchInit = 0;
+epicsExportAddress(int, regDevBatchInit);
+epicsShareDef int regDevBatchInitGap = 0;
+epicsExportAddress(int, regDevBatchInitGap);
+
+/* When enabled, the batched readbacks (and an initial block read of
+ * block devices) run in one thread per device.
+ */
+epicsShareDef int regDevParallelInit = 0;
+epicsExportAddress(int, regDevParallelInit);
+
+struct regDevInitRead {
+    struct regDevInitRead* next;
+    dbCommon* record;
+    size_t offset;
+    epicsUInt8 dlen;
+    size_t nelem;
+    DEVSUPFUN updater;                 /* Converts the readback */
+    char* data;                        /* NULL if batched read failed */
+};
+
+struct regDevInitBuffer {
+    struct regDevInitBuffer* next;
+    epicsUInt64 data[1];
+};
+
+static int initDistributing = 0;       /* batched readbacks are being distributed */
+static dbCommon* initRecord = NULL;    /* record currently served from batch */
+static char* initData = NULL;
+static dbCommon* initUpdaterRecord = NULL; /* record in init_record */
+static DEVSUPFUN initUpdater = NULL;   /* its update function */
+
+/* called by regDevRead at init: returns 1 if the read has been handled */
+static int regDevInitReadback(dbCommon* record, size_t offset, epicsUInt8 dlen, size_t nelem, void* buffer, int* pstatus)
+{
+    regDevPrivate* priv = record->dpvt;
+    regDeviceNode* device = priv->device;
+    struct regDevInitRead* entry;
+    DEVSUPFUN updater;
+
+    if (initDistributing)
+    {
+        if (record != initRecord || !initData) return 0;
+        /* data has been swapped by the driver already */
+        regDevCopy(dlen, nelem, initData, buffer, NULL, REGDEV_NO_SWAP);
+        regDevDebugLog(DBG_INIT, "%s: readback from batched read of %s:0x%" Z "x\n",
+            record->name, device->name, offset);
+        *pstatus = S_dev_success;
+        return 1;
+    }
+
+    /* the update function of the record converts the value later */
+    updater = record == initUpdaterRecord ? initUpdater : NULL;
+
+    /* block devices only profit if the block is read at init */
+    if (!updater || priv->rboffset == DONT_INIT || !dlen || !nelem ||
+        priv->fifopacking || priv->interlace ||
+        ((device->blockModes & REGDEV_BLOCK_READ) && !regDevParallelInit) ||
+        !device->support->read)
+        return 0;
+
+    entry = callocMustSucceed(1, sizeof(struct regDevInitRead), "regDevInitReadback");
+    entry->record = record;
+    entry->offset = offset;
+    entry->dlen = dlen;
+    entry->nelem = nelem;
+    entry->updater = updater;
+    entry->next = device->initReads;
+    device->initReads = entry;
+    device->initReadCount++;
+    regDevDebugLog(DBG_INIT, "%s: readback of %s:0x%" Z "x deferred\n",
+        record->name, device->name, offset);
+    priv->asyncOffset = offset;
+    *pstatus = ASYNC_COMPLETION;
+    return 1;
+}
+
+static int regDevInitReadCompare(const void* a, const void* b)
+{
+    const struct regDevInitRead* ea = *(const struct regDevInitRead**)a;
+    const struct regDevInitRead* eb = *(const struct regDevInitRead**)b;
+    if (ea->dlen != eb->dlen) return ea->dlen < eb->dlen ? -1 : 1;
+    if (ea->offset != eb->offset) return ea->offset < eb->offset ? -1 : 1;
+    return 0;
+}
+
+/* read all deferred readbacks of one device in as few transfers as possible */
+static void regDevInitReadDevice(regDeviceNode* device)
+{
+    struct regDevInitRead** sorted;
+    struct regDevInitRead* entry;
+    size_t n = device->initReadCount;
+    size_t i, j, k;
+    size_t transfers = 0;
+
+    if (device->blockModes & REGDEV_BLOCK_READ)
+    {
+        /* readbacks of block devices copy from the block buffer */
+        int status;
+
+        if (!regDevParallelInit || !device->support->read || !device->blockBuffer)
+            return;
+        epicsMutexLock(device->accesslock);
+        regDevBlockUpdateBegin(device);
+        status = device->support->read(device->driver, 0, 1, device->size,
+            device->blockBuffer, 2, NULL, device->name);
+        regDevBlockUpdateEnd(device, device->name);
+        epicsMutexUnlock(device->accesslock);
+        if (status != S_dev_success)
+            errlogPrintf("regDevInitReadDevice %s: initial block read failed with status 0x%x\n",
+                device->name, status);
+        else
+            regDevDebugLog(DBG_INIT, "%s: initial block read done\n", device->name);
+        return;
+    }
+    if (!n) return;
+    sorted = mallocMustSucceed(n * sizeof(struct regDevInitRead*), "regDevInitReadDevice");
+    for (i = 0, entry = device->initReads; entry; entry = entry->next)
+        sorted[i++] = entry;
+    qsort(sorted, n, sizeof(struct regDevInitRead*), regDevInitReadCompare);
+
+    for (i = 0; i < n; i = j)
+    {
+        /* merge ranges with same element size which overlap or have a small gap */
+        epicsUInt8 dlen = sorted[i]->dlen;
+        size_t start = sorted[i]->offset;
+        size_t end = start + dlen * sorted[i]->nelem;
+        struct regDevInitBuffer* buffer;
+        int status;
+
+        for (j = i + 1; j < n; j++)
+        {
+            size_t next = sorted[j]->offset;
+            if (sorted[j]->dlen != dlen ||
+                next > end + regDevBatchInitGap ||
+                (next - start) % dlen)
+                break;
+            if (next + dlen * sorted[j]->nelem > end)
+                end = next + dlen * sorted[j]->nelem;
+        }
+        /* gaps are multiples of dlen because all offsets are aligned to start */
+        buffer = malloc(sizeof(struct regDevInitBuffer) + end - start);
+        if (!buffer)
+        {
+            errlogPrintf("regDevInitReadDevice %s: out of memory\n", device->name);
+            continue;
+        }
+        epicsMutexLock(device->accesslock);
+        status = device->support->read(device->driver, start, dlen, (end - start) / dlen,
+            buffer->data, 0, NULL, device->name);
+        regDevGetTimestamp(device, device->name, NULL);
+        if (status == S_dev_success)
+            regDevShadowUpdate(device, start, end - start, buffer->data);
+        epicsMutexUnlock(device->accesslock);
+        transfers++;
+        regDevDebugLog(DBG_INIT, "%s: batched read of %" Z "u records 0x%" Z "x-0x%" Z "x returned 0x%x\n",
+            device->name, j - i, start, end - 1, status);
+        if (status != S_dev_success)
+        {
+            /* records will read individually */
+            free(buffer);
+            continue;
+        }
+        buffer->next = device->initBuffers;
+        device->initBuffers = buffer;
+        for (k = i; k < j; k++)
+            sorted[k]->data = (char*)buffer->data + (sorted[k]->offset - start);
+    }
+    free(sorted);
+    regDevDebugLog(DBG_INIT, "%s: %" Z "u readbacks in %" Z "u transfers\n",
+        device->name, n, transfers);
+}
+
+/* give the values to the records and clean up */
+static void regDevInitDistribute(regDeviceNode* device)
+{
+    struct regDevInitRead* entry;
+    struct regDevInitBuffer* buffer;
+
+    initDistributing = 1;
+    while ((entry = device->initReads) != NULL)
+    {
+        dbCommon* record = entry->record;
+
+        device->initReads = entry->next;
+        initRecord = record;
+        initData = entry->data;
+        dbScanLock(record);
+        entry->updater(record);
+        dbScanUnlock(record);
+        free(entry);
+    }
+    initRecord = NULL;
+    initData = NULL;
+    initDistributing = 0;
+    device->initReadCount = 0;
+    while ((buffer = device->initBuffers) != NULL)
+    {
+        device->initBuffers = buffer->next;
+        free(buffer);
+    }
+}
+
+static void regDevInitReadDeviceProfiled(regDeviceNode* device)
+{
+    epicsTimeStamp start, end;
+
+    if (!regDevInitProfile)
+    {
+        regDevInitReadDevice(device);
+        return;
+    }
+    epicsTimeGetCurrent(&start);
+    regDevInitReadDevice(device);
+    epicsTimeGetCurrent(&end);
+    regDevInitProfileAdd(NULL, device, REGDEV_INIT_BATCH, epicsTimeDiffInSeconds(&end, &start));
+}
+
+static void regDevInitThread(regDeviceNode* device)
+{
+    regDevInitReadDeviceProfiled(device);
+    epicsEventSignal(device->initDone);
+}
+
+static void regDevInitReadbacks(void)
+{
+    regDeviceNode* device;
+
+    initUpdaterRecord = NULL;
+
+    if (regDevParallelInit)
+    {
+        /* the slowest device, not the sum of all devices, defines the init time */
+        for (device = registeredDevices; device; device = device->next)
+        {
+            char threadName[32];
+
+            if (!device->initReadCount && !(device->blockModes & REGDEV_BLOCK_READ))
+                continue;
+            device->initDone = epicsEventMustCreate(epicsEventEmpty);
+            epicsSnprintf(threadName, sizeof(threadName), "%s-init", device->name);
+            if (!epicsThreadCreate(threadName, epicsThreadGetPrioritySelf(),
+                epicsThreadGetStackSize(epicsThreadStackSmall),
+                (EPICSTHREADFUNC) regDevInitThread, device))
+            {
+                errlogPrintf("regDevInit %s: cannot start init thread\n", device->name);
+                regDevInitThread(device);
+            }
+        }
+        for (device = registeredDevices; device; device = device->next)
+        {
+            if (!device->initDone) continue;
+            epicsEventMustWait(device->initDone);
+            epicsEventDestroy(device->initDone);
+            device->initDone = NULL;
+        }
+    }
+    else
+    {
+        for (device = registeredDevices; device; device = device->next)
+            regDevInitReadDeviceProfiled(device);
+    }
+    for (device = registeredDevices; device; device = device->next)
+        regDevInitDistribute(device);
+}
+
 long regDevInit(int finished)
 {
     if (atInit && finished)
     {
+        /* still atInit: readbacks use rboffset and read synchronously */
+        regDevInitReadbacks();
         atInit = 0;
         regDevDebugLog(DBG_INIT, "init finished\n");
+        regDevDebugLog(DBG_INIT, "parsed %lu links in %.3f s, %lu option cache hits, %lu cache entries\n",
+            regDevParseStats.links, regDevParseStats.seconds,
+            regDevParseStats.hits, regDevParseStats.entries);
+        /* no more links to parse */
+        regDevParseCacheFree();
     }
     return S_dev_success;
 }
@@ -1395,8 +3612,10 @@ int regDevGetOffset(dbCommon* record, epicsUInt8 dlen, size_t nelem, size_t *pof
     }
     else
     {
+        regDevPrivateExt* ext = priv->ext;
+
         offset = priv->offset;
-        if (priv->offsetRecord)
+        if (ext && ext->offsetRecord)
         {
             struct {
                 DBRstatus
@@ -1405,21 +3624,22 @@ int regDevGetOffset(dbCommon* record, epicsUInt8 dlen, size_t nelem, size_t *pof
             long options = DBR_STATUS;
             ptrdiff_t off = offset;
 
-            status = dbGetField(priv->offsetRecord, DBR_LONG, &buffer, &options, NULL, NULL);
+            /* with the lock of the offset record: it may be written any time */
+            status = dbGetField(ext->offsetRecord, DBR_LONG, &buffer, &options, NULL, NULL);
             if (status == S_dev_success && buffer.severity == INVALID_ALARM) status = S_dev_badArgument;
             if (status != S_dev_success)
             {
                 recGblSetSevr(record, LINK_ALARM, INVALID_ALARM);
                 errlogPrintf("%s: cannot read offset from '%s'\n",
-                    record->name, priv->offsetRecord->precord->name);
+                    record->name, ext->offsetRecord->precord->name);
                 return status;
             }
-            off += buffer.i * priv->offsetScale;
+            off += buffer.i * ext->offsetScale;
             if (off < 0)
             {
                 errlogPrintf("%s: effective offset '%s'=%d * %" Z "d + %" Z "u = %" Z "d < 0\n",
-                    record->name, priv->offsetRecord->precord->name,
-                    buffer.i, priv->offsetScale, offset, off);
+                    record->name, ext->offsetRecord->precord->name,
+                    buffer.i, ext->offsetScale, offset, off);
                 return S_dev_badSignalNumber;
             }
             offset = off;
@@ -1450,8 +3670,102 @@ int regDevGetOffset(dbCommon* record, epicsUInt8 dlen, size_t nelem, size_t *pof
     return S_dev_success;
 }
 
-/*********  I/O functions ****************************/
-
+/*********  I/O functions ****************************/
+
+/*********  Input deadband ****************************/
+
+static double regDevRawValue(regDevPrivate* priv, const void* raw)
+{
+    epicsUInt64 mask = priv->mask ? priv->mask : ~(epicsUInt64)0;
+
+    /* value as regDevRead delivers it, before any conversion */
+    switch (priv->dtype)
+    {
+        case epicsInt8T:
+            return (epicsInt8)((*(const epicsUInt8*)raw & mask) ^ priv->invert);
+        case epicsUInt8T:
+        case regDevBCD8T:
+            return (epicsUInt8)((*(const epicsUInt8*)raw & mask) ^ priv->invert);
+        case epicsInt16T:
+            return (epicsInt16)((*(const epicsUInt16*)raw & mask) ^ priv->invert);
+        case epicsUInt16T:
+        case regDevBCD16T:
+            return (epicsUInt16)((*(const epicsUInt16*)raw & mask) ^ priv->invert);
+        case epicsInt32T:
+            return (epicsInt32)((*(const epicsUInt32*)raw & mask) ^ priv->invert);
+        case epicsUInt32T:
+        case regDevBCD32T:
+            return (epicsUInt32)((*(const epicsUInt32*)raw & mask) ^ priv->invert);
+        case epicsInt64T:
+            return (double)(epicsInt64)((*(const epicsUInt64*)raw & mask) ^ priv->invert);
+        case epicsUInt64T:
+        case regDevBCD64T:
+            return (double)((*(const epicsUInt64*)raw & mask) ^ priv->invert);
+        case epicsFloat32T:
+            return *(const epicsFloat32*)raw;
+        case epicsFloat64T:
+            return *(const epicsFloat64*)raw;
+    }
+    return 0.0;
+}
+
+/* compare with the last processed input, remember it if changed */
+static int regDevInputUnchanged(regDevPrivate* priv, unsigned int dlen, size_t nelem, const void* raw)
+{
+    regDevPrivateExt* ext = priv->ext;
+    size_t size = dlen * nelem;
+    epicsUInt64 mask = priv->mask ? priv->mask : ~(epicsUInt64)0;
+    size_t i = 0;
+
+    if (ext->lastRawValid && ext->lastRawSize == size)
+    {
+        if (nelem == 1 && ext->deadband > 0)
+        {
+            if (fabs(regDevRawValue(priv, raw) - regDevRawValue(priv, ext->lastRaw)) <= ext->deadband)
+                return 1;
+        }
+        else switch (dlen)
+        {
+            /* only bits in mask count */
+            case 1:
+                for (i = 0; i < nelem; i++)
+                    if ((((const epicsUInt8*)raw)[i] ^ ((epicsUInt8*)ext->lastRaw)[i]) & (epicsUInt8)mask)
+                        break;
+                if (i == nelem) return 1;
+                break;
+            case 2:
+                for (i = 0; i < nelem; i++)
+                    if ((((const epicsUInt16*)raw)[i] ^ ((epicsUInt16*)ext->lastRaw)[i]) & (epicsUInt16)mask)
+                        break;
+                if (i == nelem) return 1;
+                break;
+            case 4:
+                for (i = 0; i < nelem; i++)
+                    if ((((const epicsUInt32*)raw)[i] ^ ((epicsUInt32*)ext->lastRaw)[i]) & (epicsUInt32)mask)
+                        break;
+                if (i == nelem) return 1;
+                break;
+            case 8:
+                for (i = 0; i < nelem; i++)
+                    if ((((const epicsUInt64*)raw)[i] ^ ((epicsUInt64*)ext->lastRaw)[i]) & mask)
+                        break;
+                if (i == nelem) return 1;
+                break;
+            default:
+                if (memcmp(ext->lastRaw, raw, size) == 0) return 1;
+        }
+    }
+    if (size != ext->lastRawSize)
+    {
+        free(ext->lastRaw);
+        ext->lastRaw = mallocMustSucceed(size, "regDevInputUnchanged");
+        ext->lastRawSize = size;
+    }
+    memcpy(ext->lastRaw, raw, size);
+    ext->lastRawValid = 1;
+    return 0;
+}
+
 void regDevCallback(const char* user, int status)
 {
     dbCommon* record = (dbCommon*)(user - offsetof(dbCommon, name));
@@ -1473,11 +3787,9 @@ void regDevCallback(const char* user, int status)
             regDevDebugLog(DBG_IN, "%s: async update failed. status=0x%x",
                 record->name, status);
         }
-        priv->updater(record);
+        priv->ext->updater(record);
         priv->updating = 0;
         dbScanUnlock(record);
-        if (priv->nextUpdate)
-            epicsTimerStartDelay(priv->nextUpdate->updateTimer, 0.0);
     }
     else
     {
@@ -1495,6 +3807,8 @@ int regDevReadWithDebug(dbCommon* record, size_t offset, unsigned int dlen, size
 
     status = device->support->read(device->driver, offset, dlen, nelem, buffer,
         prio, atInit ? NULL : regDevCallback, record->name);
+    if (status == S_dev_success)
+        regDevShadowUpdate(device, offset, dlen * nelem, buffer);
     if (record->tpro >= 2)
     {
         printf("  %s: read %llu * %u bytes from %s\n", record->name, (unsigned long long)nelem, dlen, device->name);
@@ -1512,6 +3826,7 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
     regDeviceNode* device;
     size_t offset;
     int blockModes;
+    int deadband = 0;
 
     regDevGetPriv();
     device = priv->device;
@@ -1522,7 +3837,8 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
     regDevDebugLog(DBG_IN, "%s: dlen=%u, nelm=%" Z "u, buffer=%p\n",
         record->name, dlen, nelem, buffer);
 
-    if (!device->support->read && !(blockModes & REGDEV_BLOCK_READ))
+    if (!device->support->read && !(blockModes & REGDEV_BLOCK_READ) &&
+        !(priv->ext && priv->ext->writeOnly))
     {
         recGblSetSevr(record, READ_ALARM, INVALID_ALARM);
         regDevDebugLog(DBG_IN, "%s: device %s has no read function\n",
@@ -1530,11 +3846,22 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
         return S_dev_badRequest;
     }
 
+    /* D= for input records (outputs only read at init and for updates) */
+    deadband = priv->ext && priv->ext->deadbandSet && !atInit && !priv->updating &&
+        !priv->fifopacking && buffer && nelem;
+
     if (record->pact)
     {
         /* Second call of asynchronous device */
         regDevDebugLog(DBG_IN, "%s: asynchronous read returned 0x%x\n",
             record->name, priv->status);
+        if ((blockModes & REGDEV_BLOCK_READ) && !device->dispatcher && device->support->read)
+        {
+            /* asynchronous driver has finished filling the block buffer */
+            epicsMutexLock(device->accesslock);
+            regDevBlockUpdateEnd(device, record->name);
+            epicsMutexUnlock(device->accesslock);
+        }
         if (priv->status != S_dev_success)
         {
             recGblSetSevr(record, READ_ALARM, INVALID_ALARM);
@@ -1549,7 +3876,22 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
         if (status != S_dev_success)
             return status;
 
-        if (!(blockModes & REGDEV_BLOCK_READ) || record->prio == 2)
+        if (priv->ext && priv->ext->writeOnly)
+        {
+            /* never read write only registers from the hardware */
+            status = regDevShadowRead(record, offset, dlen, nelem, buffer);
+        }
+        else if (atInit && (regDevBatchInit || regDevParallelInit || initDistributing) &&
+            regDevInitReadback(record, offset, dlen, nelem, buffer, &status))
+        {
+            /* readback deferred to or served from batched read */
+        }
+        else if (priv->updating && priv->ext->group &&
+            regDevUpdateFromGroup(record, offset, dlen, nelem, buffer, &status))
+        {
+            /* update served from group read */
+        }
+        else if (!(blockModes & REGDEV_BLOCK_READ) || record->prio == 2)
         {
             /* read from the hardware (directly or to fill the block buffer) */
             record->pact = 1;
@@ -1579,6 +3921,8 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
                 }
                 regDevDebugLog(DBG_IN, "%s: sending read to %s prio %d dispatcher\n",
                     record->name, device->name, record->prio);
+                msg.timed = regDevWorkStats;
+                if (msg.timed) regDevWorkTimeGet(&msg.queued);
                 if (epicsMessageQueueTrySend(device->dispatcher->qid[record->prio], &msg, sizeof(msg)) != 0)
                 {
                     recGblSetSevr(record, SOFT_ALARM, INVALID_ALARM);
@@ -1590,6 +3934,9 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
             }
             else
             {
+                epicsTimeStamp start, end;
+
+                if (atInit && regDevInitProfile) epicsTimeGetCurrent(&start);
                 /* synchronous read */
                 regDevDebugLog(DBG_IN, "%s: reading %s from %s\n",
                     record->name,
@@ -1604,8 +3951,14 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
                        (directly mapped blocks need no read function)
                     */
                     if (device->support->read)
+                    {
+                        regDevBlockUpdateBegin(device);
                         status = regDevReadWithDebug(record,
                             0, 1, device->size, device->blockBuffer, 2);
+                        /* asynchronous fills end in the second call */
+                        if (status != ASYNC_COMPLETION)
+                            regDevBlockUpdateEnd(device, record->name);
+                    }
                 }
                 else if (priv->interlace)
                 {
@@ -1623,6 +3976,12 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
                         offset, dlen, nelem, buffer, record->prio);
 
                 epicsMutexUnlock(device->accesslock);
+                if (atInit && regDevInitProfile)
+                {
+                    epicsTimeGetCurrent(&end);
+                    regDevInitProfileAdd(record, device, REGDEV_INIT_READBACK,
+                        epicsTimeDiffInSeconds(&end, &start));
+                }
                 regDevDebugLog(DBG_IN, "%s: read returned status 0x%0x\n", record->name, status);
             }
         }
@@ -1639,36 +3998,70 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
                 if (device->blockBuffer <= buffer && buffer < device->blockBuffer + device->size)
                 {
                     /* array is directly mapped into blockBuffer and needs no copy */
+                    if (record->tse == epicsTimeEventDeviceTime)
+                        record->time = device->blockTime;
                     regDevDebugLog(DBG_IN, "%s: %" Z "u * %u bytes mapped in %s block buffer %p+0x%" Z "x\n",
                         record->name, nelem, dlen, device->name, device->blockBuffer, offset);
                 }
                 else
                 {
-                    /* copy block buffer to record */
+                    /* copy block buffer to record without locking:
+                       retry if the block buffer has been updated meanwhile */
+                    epicsUInt32 seq;
+                    int retries = 0;
+
                     regDevDebugLog(DBG_IN, "%s: copy %" Z "u * %u bytes from %s block buffer %p+0x%" Z "x to record buffer %p\n",
                         record->name, nelem, dlen, device->name, device->blockBuffer, offset, buffer);
-                    if (priv->interlace)
+                    do {
+                        while ((seq = device->blockSeq) & 1)
+                        {
+                            if (++retries > BLOCK_READ_RETRIES) break;
+                            epicsThreadSleep(0.0);
+                        }
+                        regDevReadBarrier();
+                        if (record->tse == epicsTimeEventDeviceTime)
+                            record->time = device->blockTime;
+                        if (priv->interlace)
+                        {
+                            /* copy interlaced arrays element-wise */
+                            size_t i;
+                            for (i = 0; i < nelem; i++)
+                                regDevCopy(dlen, 1,
+                                    device->blockBuffer + offset + i*priv->interlace,
+                                    buffer + i*dlen, NULL, device->swap);
+                        }
+                        else
+                            regDevCopy(dlen, nelem, device->blockBuffer + offset, buffer, NULL, device->swap);
+                        regDevReadBarrier();
+                    } while (device->blockSeq != seq && ++retries <= BLOCK_READ_RETRIES);
+                    if (retries > BLOCK_READ_RETRIES)
                     {
-                        /* copy interlaced arrays element-wise */
-                        size_t i;
-                        for (i = 0; i < nelem; i++)
-                            regDevCopy(dlen, 1,
-                                device->blockBuffer + offset + i*priv->interlace,
-                                buffer + i*dlen, NULL, device->swap);
+                        /* block buffer update did not finish in time: copy is inconsistent */
+                        status = S_dev_deviceTMO;
+                        regDevDebugLog(DBG_IN, "%s: %s block buffer busy, copy is inconsistent\n",
+                            record->name, device->name);
                     }
-                    else
-                        regDevCopy(dlen, nelem, device->blockBuffer + offset, buffer, NULL, device->swap);
                 }
             }
 
             if (record->prio == 2 && !atInit)
             {
                 /* inform other input records of new block data available */
-                scanIoRequest(device->blockReceived);
+                regDevScanIoRequestNode(device, device->blockReceived);
             }
         }
+        else if (record->tse == epicsTimeEventDeviceTime)
+        {
+            /* time stamp from driver or time of completion */
+            if (!regDevGetTimestamp(device, record->name, &record->time))
+                epicsTimeGetCurrent(&record->time);
+        }
     }
 
+    /* compare raw data before mask is applied in place */
+    if (deadband && status == S_dev_success && !regDevInputUnchanged(priv, dlen, nelem, buffer))
+        deadband = 0;
+
     if ((priv->mask || priv->invert) && status == S_dev_success)
     {
         size_t i;
@@ -1756,12 +4149,20 @@ int regDevRead(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf)
         recGblSetSevr(record, READ_ALARM, INVALID_ALARM);
         regDevDebugLog(DBG_IN, "%s: read error\n", record->name);
     }
+    else if (deadband)
+    {
+        /* record finishes processing but keeps its value */
+        device->skippedInputs++;
+        regDevDebugLog(DBG_IN, "%s: input unchanged\n", record->name);
+        return REGDEV_UNCHANGED;
+    }
     return status;
 }
 
 int regDevWriteWithDebug(dbCommon* record, size_t offset, unsigned int dlen, size_t nelem, void* buffer, void* pmask, int prio)
 {
     regDeviceNode* device;
+    int status;
     regDevGetPriv();
     device = priv->device;
 
@@ -1770,8 +4171,11 @@ int regDevWriteWithDebug(dbCommon* record, size_t offset, unsigned int dlen, siz
         printf("  %s: write %llu * %u bytes %sto %s\n", record->name, (unsigned long long)nelem, dlen, pmask ? " masked" : "", device->name);
         memDisplay(0, buffer, dlen, dlen * nelem);
     }
-    return device->support->write(device->driver, offset, dlen, nelem, buffer, pmask,
+    pmask = regDevShadowMerge(device, offset, dlen, nelem, buffer, pmask, buffer == &priv->data);
+    status = device->support->write(device->driver, offset, dlen, nelem, buffer, pmask,
         prio, atInit ? NULL : regDevCallback, record->name);
+    regDevShadowWritten(device, offset, dlen, nelem, buffer, pmask, status, record->name);
+    return status;
 }
 
 int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epicsUInt64 mask)
@@ -1794,6 +4198,9 @@ int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epic
     regDevDebugLog(DBG_OUT, "%s: dlen=%u, nelm=%" Z "u, buffer=%p mask=%llx M=%llx\n",
         record->name, dlen, nelem, buffer, (unsigned long long)mask, (unsigned long long)priv->mask);
 
+    /* the next update must not be skipped even if the register has not changed */
+    if (priv->ext) priv->ext->lastRawValid = 0;
+
     if (!device->support->write && !(blockModes & REGDEV_BLOCK_WRITE))
     {
         recGblSetSevr(record, WRITE_ALARM, INVALID_ALARM);
@@ -1807,15 +4214,24 @@ int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epic
         /* Second call of asynchronous device */
         regDevDebugLog(DBG_OUT, "%s: asynchronous write returned %d\n",
             record->name, priv->status);
+        if (device->shadow)
+        {
+            /* the shadow takes asynchronous writes only now */
+            epicsMutexLock(device->accesslock);
+            regDevShadowCompleted(device, record->name, priv->status);
+            epicsMutexUnlock(device->accesslock);
+        }
         if (priv->status != S_dev_success)
+        {
             recGblSetSevr(record, WRITE_ALARM, INVALID_ALARM);
+        }
         else
         if ((blockModes & REGDEV_BLOCK_WRITE) &&
             record->prio == 2 &&
             !atInit)
         {
             /* inform other output records that block has been sent */
-            scanIoRequest(device->blockSent);
+            regDevScanIoRequestNode(device, device->blockSent);
         }
         return priv->status;
     }
@@ -1981,6 +4397,7 @@ int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epic
     }
 
     priv->status = S_dev_success;
+    priv->asyncOffset = offset;
     record->pact = 1;
     if (device->dispatcher && device->support->write)
     {
@@ -2006,6 +4423,8 @@ int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epic
         }
         regDevDebugLog(DBG_OUT, "%s: sending write to %s prio %d dispatcher\n",
             record->name, device->name, record->prio);
+        msg.timed = regDevWorkStats;
+        if (msg.timed) regDevWorkTimeGet(&msg.queued);
         if (epicsMessageQueueTrySend(device->dispatcher->qid[record->prio], &msg, sizeof(msg)) != 0)
         {
             recGblSetSevr(record, SOFT_ALARM, INVALID_ALARM);
@@ -2076,7 +4495,7 @@ int regDevWrite(dbCommon* record, epicsUInt8 dlen, size_t nelem, void* buf, epic
         !atInit)
     {
         /* inform other output records that block has been sent */
-        scanIoRequest(device->blockSent);
+        regDevScanIoRequestNode(device, device->blockSent);
     }
     return status;
 }
@@ -2405,7 +4824,8 @@ int regDevReadArray(dbCommon* record, size_t nelm)
             dlen, nelm, priv->data.buffer);
     }
 
-    if (status != S_dev_success) return status;
+    /* unchanged data has been read again and needs conversion in place */
+    if (status != S_dev_success && status != REGDEV_UNCHANGED) return status;
 
     switch (priv->dtype)
     {
@@ -2443,7 +4863,7 @@ int regDevReadArray(dbCommon* record, size_t nelm)
         if (priv->dtype == epicsStringT)
             printf("  %s: VAL = \"%s\"\n", record->name, (char*)priv->data.buffer);
     }
-    return S_dev_success;
+    return status;
 }
 
 int regDevWriteArray(dbCommon* record, size_t nelm)
@@ -2910,7 +5330,9 @@ int regDevScaleToRaw(dbCommon* record, int ftvl, void* val, size_t nelm, double
 
 /*********  Output updates from hardware ****************************/
 
-void regDevRunUpdater(dbCommon* record)
+/* returns 1 if the update continues asynchronously,
+   *pstatus is only set if the updater has run synchronously */
+static int regDevUpdateRecord(dbCommon* record, int* pstatus)
 {
     int status;
     int pact = 0;
@@ -2926,12 +5348,13 @@ void regDevRunUpdater(dbCommon* record)
             priv->updating = 1;
             if (record->tpro)
                 printf ("Update %s\n", record->name);
-            status = priv->updater(record);
+            status = priv->ext->updater(record);
             recGblGetTimeStamp(record);
             pact = record->pact;
             if (!pact)
             {
                 priv->updating = 0;
+                if (pstatus) *pstatus = status;
                 if (status != S_dev_success)
                 {
                     regDevDebugLog(DBG_IN, "%s: update failed. status=0x%x",
@@ -2941,27 +5364,468 @@ void regDevRunUpdater(dbCommon* record)
         }
         dbScanUnlock(record);
     }
-    if (!pact)
+    return pact;
+}
+
+/* Skip updates of records whose raw data has not changed */
+epicsShareDef int regDevSkipUnchangedUpdates = 0;
+epicsExportAddress(int, regDevSkipUnchangedUpdates);
+
+/* Periodic updates (U=msec) of records with the same period on the same
+   device share one timer. Triggered updates (U=T) of a device form a group
+   with period -1 which runs when triggered.
+   The registers of all records in the group are read in as few transfers
+   as possible and then each record updates from that data.
+   The transfer of each record is learned from its first update.
+*/
+
+/* called by regDevRead for updates: returns 1 if the read has been handled */
+static int regDevUpdateFromGroup(dbCommon* record, size_t offset, epicsUInt8 dlen, size_t nelem, void* buffer, int* pstatus)
+{
+    regDevPrivate* priv = record->dpvt;
+    regDevPrivateExt* ext = priv->ext;
+
+    if (ext->updateOffset != offset || ext->updateDlen != dlen || ext->updateNelem != nelem)
+    {
+        /* learn the transfer of this record for the next cycle */
+        ext->updateOffset = offset;
+        ext->updateDlen = dlen;
+        ext->updateNelem = nelem;
+        ext->group->layoutValid = 0;
+        return 0;
+    }
+    if (!ext->updateData) return 0;
+    /* data has been swapped by the driver already */
+    regDevCopy(dlen, nelem, ext->updateData, buffer, NULL, REGDEV_NO_SWAP);
+    regDevDebugLog(DBG_IN, "%s: update from group read of %s:0x%" Z "x\n",
+        record->name, priv->device->name, offset);
+    *pstatus = S_dev_success;
+    return 1;
+}
+
+/* returns 1 if the group read the same data for this record as last time */
+static int regDevUpdateUnchanged(regDevPrivateExt* ext)
+{
+    return ext->lastRawValid && ext->lastRawSize == (size_t)ext->updateDlen * ext->updateNelem &&
+        memcmp(ext->lastRaw, ext->updateData, ext->lastRawSize) == 0;
+}
+
+/* remember the data the record has updated from */
+static void regDevUpdateCommitRaw(regDevPrivateExt* ext)
+{
+    size_t size = ext->updateDlen * ext->updateNelem;
+
+    if (size != ext->lastRawSize)
+    {
+        free(ext->lastRaw);
+        ext->lastRaw = mallocMustSucceed(size, "regDevUpdateCommitRaw");
+        ext->lastRawSize = size;
+    }
+    memcpy(ext->lastRaw, ext->updateData, size);
+    ext->lastRawValid = 1;
+}
+
+static int regDevUpdateCompare(const void* a, const void* b)
+{
+    const regDevPrivateExt* ea = ((regDevPrivate*)(*(dbCommon* const*)a)->dpvt)->ext;
+    const regDevPrivateExt* eb = ((regDevPrivate*)(*(dbCommon* const*)b)->dpvt)->ext;
+    if (ea->updateDlen != eb->updateDlen) return ea->updateDlen < eb->updateDlen ? -1 : 1;
+    if (ea->updateOffset != eb->updateOffset) return ea->updateOffset < eb->updateOffset ? -1 : 1;
+    return 0;
+}
+
+static void regDevUpdateGroupLayout(struct regDevUpdateGroup* group)
+{
+    regDeviceNode* device = group->device;
+    dbCommon** sorted;
+    size_t n = 0, i, j, k;
+    size_t size = 0;
+
+    sorted = mallocMustSucceed(group->count * sizeof(dbCommon*), "regDevUpdateGroupLayout");
+    for (i = 0; i < group->count; i++)
+    {
+        dbCommon* record = group->records[i];
+        regDevPrivate* priv = record->dpvt;
+
+        priv->ext->updateRange = -1;
+        /* block devices update from the block buffer */
+        if (!priv->ext->updateDlen || !priv->ext->updateNelem ||
+            priv->interlace || priv->fifopacking || priv->ext->writeOnly ||
+            (device->blockModes & REGDEV_BLOCK_READ))
+            continue;
+        sorted[n++] = record;
+    }
+    qsort(sorted, n, sizeof(dbCommon*), regDevUpdateCompare);
+
+    group->rangeCount = 0;
+    for (i = 0; i < n; i = j)
+    {
+        /* merge ranges with same element size which overlap or touch */
+        regDevPrivateExt* ext = ((regDevPrivate*)sorted[i]->dpvt)->ext;
+        epicsUInt8 dlen = ext->updateDlen;
+        size_t start = ext->updateOffset;
+        size_t end = start + dlen * ext->updateNelem;
+        struct regDevUpdateRange* range;
+
+        for (j = i + 1; j < n; j++)
+        {
+            ext = ((regDevPrivate*)sorted[j]->dpvt)->ext;
+            if (ext->updateDlen != dlen ||
+                ext->updateOffset > end ||
+                (ext->updateOffset - start) % dlen)
+                break;
+            if (ext->updateOffset + dlen * ext->updateNelem > end)
+                end = ext->updateOffset + dlen * ext->updateNelem;
+        }
+        group->ranges = realloc(group->ranges, (group->rangeCount + 1) * sizeof(struct regDevUpdateRange));
+        if (!group->ranges)
+            cantProceed("regDevUpdateGroupLayout: out of memory\n");
+        range = &group->ranges[group->rangeCount];
+        range->offset = start;
+        range->dlen = dlen;
+        range->nelem = (end - start) / dlen;
+        range->bufferOffset = size;
+        for (k = i; k < j; k++)
+        {
+            ext = ((regDevPrivate*)sorted[k]->dpvt)->ext;
+            ext->updateRange = (int)group->rangeCount;
+            ext->updateDataOffset = size + (ext->updateOffset - start);
+        }
+        group->rangeCount++;
+        size += (end - start + 7) & ~(size_t)7;
+    }
+    free(sorted);
+    if (size > group->bufferSize)
+    {
+        free(group->buffer);
+        group->buffer = mallocMustSucceed(size, "regDevUpdateGroupLayout");
+        group->bufferSize = size;
+    }
+    group->layoutValid = 1;
+    regDevDebugLog(DBG_IN, "%s: update group %d ms with %" Z "u records uses %" Z "u transfers\n",
+        device->name, group->period, group->count, group->rangeCount);
+}
+
+static unsigned int regDevPendingRequests(regDeviceNode* device)
+{
+    unsigned int pending = 0;
+    int prio;
+
+    if (!device->dispatcher) return 0;
+    for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++)
+        if (device->dispatcher->qid[prio])
+            pending += epicsMessageQueuePending(device->dispatcher->qid[prio]);
+    return pending;
+}
+
+static void regDevUpdateAdaptDelay(struct regDevUpdateGroup* group)
+{
+    regDeviceNode* device = group->device;
+    double period = group->period * 0.001;
+    double maxDelay = period * device->updateMaxFactor;
+    unsigned int pending = regDevPendingRequests(device);
+
+    if (group->serviceTime > group->delay * device->updateBusyFraction ||
+        (device->updateQueueLimit && pending >= device->updateQueueLimit))
+    {
+        /* device is busy: make room for other requests */
+        if (group->delay < maxDelay)
+        {
+            group->delay *= 2;
+            if (group->delay > maxDelay)
+                group->delay = maxDelay;
+            group->backoffs++;
+            regDevDebugLog(DBG_OUT, "%s: update group %d ms backs off to %.0f ms"
+                " (service %.3f ms, %u pending)\n",
+                device->name, group->period, group->delay * 1000,
+                group->serviceTime * 1000, pending);
+        }
+    }
+    else if (group->delay > period)
+    {
+        /* recover gradually */
+        group->delay -= (group->delay - period) * 0.25;
+        if (group->delay - period < period * 0.01)
+            group->delay = period;
+    }
+    if (group->delay < period)
+        group->delay = period;
+}
+
+static void regDevRunUpdateGroup(struct regDevUpdateGroup* group)
+{
+    regDeviceNode* device = group->device;
+    epicsTimeStamp start, end;
+    size_t i;
+
+    if (interruptAccept)
+    {
+        if (!group->layoutValid)
+            regDevUpdateGroupLayout(group);
+        /* only the device transfers count for backoff */
+        epicsTimeGetCurrent(&start);
+        for (i = 0; i < group->rangeCount; i++)
+        {
+            struct regDevUpdateRange* range = &group->ranges[i];
+
+            epicsMutexLock(device->accesslock);
+            range->status = device->support->read(device->driver, range->offset, range->dlen,
+                range->nelem, group->buffer + range->bufferOffset, 0, NULL, device->name);
+            /* not used for updates, do not leave it to the next block read */
+            regDevGetTimestamp(device, device->name, NULL);
+            if (range->status == S_dev_success)
+                regDevShadowUpdate(device, range->offset, range->dlen * range->nelem,
+                    group->buffer + range->bufferOffset);
+            epicsMutexUnlock(device->accesslock);
+            group->transfers++;
+            if (range->status != S_dev_success)
+            {
+                /* records read individually */
+                group->errors++;
+                regDevDebugLog(DBG_IN, "%s: group read 0x%" Z "x-0x%" Z "x returned 0x%x\n",
+                    device->name, range->offset, range->offset + range->dlen * range->nelem - 1,
+                    range->status);
+            }
+        }
+        epicsTimeGetCurrent(&end);
+        group->serviceTime = epicsTimeDiffInSeconds(&end, &start);
+        for (i = 0; i < group->count; i++)
+        {
+            dbCommon* record = group->records[i];
+            regDevPrivateExt* ext = ((regDevPrivate*)record->dpvt)->ext;
+            int status = S_dev_badRequest;
+
+            if (ext->updateRange >= 0 && group->ranges[ext->updateRange].status == S_dev_success)
+            {
+                ext->updateData = group->buffer + ext->updateDataOffset;
+                if (regDevSkipUnchangedUpdates && regDevUpdateUnchanged(ext))
+                {
+                    /* nothing to convert or to post */
+                    ext->updateData = NULL;
+                    group->unchanged++;
+                    continue;
+                }
+            }
+            regDevUpdateRecord(record, &status);
+            /* only skip later if the record really got this data */
+            if (regDevSkipUnchangedUpdates && ext->updateData && status == S_dev_success)
+                regDevUpdateCommitRaw(ext);
+            else
+                ext->lastRawValid = 0;
+            ext->updateData = NULL;
+        }
+        group->cycles++;
+        if (group->period > 0)
+            regDevUpdateAdaptDelay(group);
+    }
+    if (group->period > 0)
+        epicsTimerStartDelay(group->timer, group->delay);
+}
+
+int regDevTriggerUpdates(regDeviceNode* device)
+{
+    struct regDevUpdateGroup* group;
+
+    for (group = device->updateGroups; group; group = group->next)
+        if (group->period < 0) break;
+    if (!group) return S_dev_success;
+    regDevDebugLog(DBG_OUT, "%s: trigger %" Z "u updates\n", device->name, group->count);
+    epicsTimerStartDelay(group->timer, 0.0);
+    return S_dev_success;
+}
+
+int regDevUpdateBackoffPolicy(const char* devName, double maxFactor, double busyFraction, int queueLimit)
+{
+    regDeviceNode* device;
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (maxFactor != 0.0 && maxFactor < 1.0)
+    {
+        errlogPrintf("maxFactor must be at least 1\n");
+        return S_dev_badArgument;
+    }
+    if (busyFraction < 0.0 || queueLimit < 0)
+    {
+        errlogPrintf("busyFraction and queueLimit must not be negative\n");
+        return S_dev_badArgument;
+    }
+    if (maxFactor != 0.0)
+        device->updateMaxFactor = maxFactor;
+    if (busyFraction != 0.0)
+        device->updateBusyFraction = busyFraction;
+    device->updateQueueLimit = queueLimit;
+    return S_dev_success;
+}
+
+struct regDevPinRequest {
+    epicsTimerId timer;
+    int cpu;
+};
+
+/* runs once in the timer queue thread */
+static void regDevPinUpdateThread(void* arg)
+{
+    struct regDevPinRequest* request = arg;
+
+    regDevSetCpuAffinity(request->cpu);
+    epicsTimerDestroy(request->timer);
+    free(request);
+}
+
+int regDevStartUpdateThreads(const char* devName, int threads, int priority, int cpu)
+{
+    regDeviceNode* device;
+    int i;
+
+    device = regDevFindNode(devName);
+    if (!device)
+    {
+        errlogPrintf("device %s not found\n", devName);
+        return S_dev_noDevice;
+    }
+    if (interruptAccept || device->updateGroups)
+    {
+        errlogPrintf("regDevStartUpdateThreads must be called before iocInit\n");
+        return S_dev_badRequest;
+    }
+    if (device->updateThreadCount)
+    {
+        errlogPrintf("device %s already has update threads\n", devName);
+        return S_dev_multDevice;
+    }
+    if (threads <= 0) threads = 1;
+    if (priority <= 0 || priority > epicsThreadPriorityMax)
+        priority = epicsThreadPriorityLow;
+
+    device->updateThreads = callocMustSucceed(threads, sizeof(epicsTimerQueueId), "regDevStartUpdateThreads");
+    for (i = 0; i < threads; i++)
+    {
+        /* not shared with other devices */
+        device->updateThreads[i] = epicsTimerQueueAllocate(0, priority);
+        if (!device->updateThreads[i])
+        {
+            errlogPrintf("%s: cannot start update thread\n", devName);
+            break;
+        }
+        if (cpu >= 0)
+        {
+            /* the queue thread pins itself, thread i to cpu+i */
+            struct regDevPinRequest* request = mallocMustSucceed(sizeof(struct regDevPinRequest),
+                "regDevStartUpdateThreads");
+            request->cpu = cpu + i;
+            request->timer = epicsTimerQueueCreateTimer(device->updateThreads[i],
+                regDevPinUpdateThread, request);
+            if (request->timer)
+                epicsTimerStartDelay(request->timer, 0.0);
+            else
+                free(request);
+        }
+    }
+    if (i == 0)
+    {
+        free(device->updateThreads);
+        device->updateThreads = NULL;
+        return S_dev_internal;
+    }
+    device->updateThreadCount = i;
+    device->updateTimerQueue = device->updateThreads[0];
+    return S_dev_success;
+}
+
+static int regDevAddToUpdateGroup(regDeviceNode* device, dbCommon* record)
+{
+    regDevPrivateExt* ext = ((regDevPrivate*)record->dpvt)->ext;
+    struct regDevUpdateGroup* group;
+    epicsTimerQueueId queue;
+
+    for (group = device->updateGroups; group; group = group->next)
+        if (group->period == (ext->update > 0 ? ext->update : -1)) break;
+    if (!group)
+    {
+        group = callocMustSucceed(1, sizeof(struct regDevUpdateGroup), "regDevAddToUpdateGroup");
+        group->device = device;
+        group->period = ext->update > 0 ? ext->update : -1;
+        group->delay = group->period * 0.001;
+        if (device->updateThreadCount)
+        {
+            /* spread groups over the dedicated threads */
+            struct regDevUpdateGroup* g;
+            unsigned int n = 0;
+
+            for (g = device->updateGroups; g; g = g->next) n++;
+            queue = device->updateThreads[n % device->updateThreadCount];
+        }
+        else if (group->period < 0)
+        {
+            /* triggers of different devices must not wait for each other */
+            queue = epicsTimerQueueAllocate(0, epicsThreadPriorityLow);
+            if (!queue)
+            {
+                free(group);
+                return S_dev_noMemory;
+            }
+        }
+        else
+            queue = device->updateTimerQueue;
+        group->timer = epicsTimerQueueCreateTimer(queue,
+            (epicsTimerCallback)regDevRunUpdateGroup, group);
+        if (!group->timer)
+        {
+            free(group);
+            return S_dev_noMemory;
+        }
+        group->next = device->updateGroups;
+        device->updateGroups = group;
+        if (group->period > 0)
+            epicsTimerStartDelay(group->timer, group->delay);
+    }
+    if (group->count == group->capacity)
     {
-        /* restart timer */
-        if (priv->update > 0)
-            epicsTimerStartDelay(priv->updateTimer, priv->update * 0.001);
-        if (priv->nextUpdate)
-            epicsTimerStartDelay(priv->nextUpdate->updateTimer, 0.0);
+        group->capacity = group->capacity ? 2 * group->capacity : 16;
+        group->records = realloc(group->records, group->capacity * sizeof(dbCommon*));
+        if (!group->records)
+            cantProceed("regDevAddToUpdateGroup: out of memory\n");
     }
+    group->records[group->count++] = record;
+    group->layoutValid = 0;
+    ext->group = group;
+    ext->updateRange = -1;
+    return S_dev_success;
 }
 
 int regDevInstallUpdateFunction(dbCommon* record, DEVSUPFUN updater)
 {
     regDeviceNode* device;
+    regDevPrivateExt* ext;
+    epicsTimeStamp start, end;
 
     regDevGetPriv();
     device = priv->device;
     assert(device != NULL);
+    ext = priv->ext;
+
+    if (ext && ext->deadbandSet)
+    {
+        regDevPrintErr("D= is only supported for input records");
+        return S_dev_badArgument;
+    }
 
-    if (priv->update && device->support->read)
+    if (atInit)
+    {
+        /* for batched readback */
+        initUpdaterRecord = record;
+        initUpdater = updater;
+    }
+
+    if (ext && ext->update && (device->support->read || ext->writeOnly))
     {
         regDevDebugLog(DBG_INIT, "%s\n", record->name);
+        if (regDevInitProfile) epicsTimeGetCurrent(&start);
         if (!device->updateTimerQueue)
         {
             device->updateTimerQueue = epicsTimerQueueAllocate(1, epicsThreadPriorityLow);
@@ -2972,21 +5836,21 @@ int regDevInstallUpdateFunction(dbCommon* record, DEVSUPFUN updater)
             }
         }
         /* install update function */
-        priv->updater = updater;
-        priv->updateTimer = epicsTimerQueueCreateTimer(device->updateTimerQueue,
-            (epicsTimerCallback)regDevRunUpdater, record);
-        if (priv->update > 0)
-        {
+        ext->updater = updater;
+        if (ext->update > 0)
             regDevDebugLog(DBG_INIT, "%s: install update every %f seconds\n",
-                record->name, priv->update * 0.001);
-            epicsTimerStartDelay(priv->updateTimer, priv->update * 0.001);
+                record->name, ext->update * 0.001);
+        else
+            regDevDebugLog(DBG_INIT, "%s: install update on trigger\n", record->name);
+        if (regDevAddToUpdateGroup(device, record) != S_dev_success)
+        {
+            regDevPrintErr("epicsTimerQueueCreateTimer failed");
+            return S_dev_noMemory;
         }
-        if (priv->update < 0)
+        if (regDevInitProfile && atInit)
         {
-            regDevPrivate** pr;
-            regDevDebugLog(DBG_INIT, "%s: install update on trigger\n", record->name);
-            for (pr = &device->triggeredUpdates; *pr; pr=&(*pr)->nextUpdate);
-            *pr = priv;
+            epicsTimeGetCurrent(&end);
+            regDevInitProfileAdd(record, device, REGDEV_INIT_UPDATER, epicsTimeDiffInSeconds(&end, &start));
         }
     }
     return S_dev_success;
@@ -3008,10 +5872,7 @@ int regDevDisplay(const char* devName, int start, unsigned int dlen, size_t byte
     size_t nelem;
 
     if (devName && *devName) {
-        for (device = registeredDevices; device; device = device->next)
-        {
-            if (strcmp(device->name, devName) == 0) break;
-        }
+        device = regDevFindNode(devName);
         if (device != save_device)
         {
             save_device = device;
@@ -3084,10 +5945,7 @@ int regDevPut(const char* devName, int offset, unsigned int dlen, int value)
     regDevAnytype buffer;
 
     if (devName && *devName) {
-        for (device = registeredDevices; device; device = device->next)
-        {
-            if (strcmp(device->name, devName) == 0) break;
-        }
+        device = regDevFindNode(devName);
     }
     if (!device)
     {
@@ -3118,6 +5976,7 @@ int regDevPut(const char* devName, int offset, unsigned int dlen, int value)
         epicsMutexLock(device->accesslock);
         status = device->support->write(device->driver,
             offset, dlen, 1, &buffer, NULL, 0, NULL, "regDevPut");
+        regDevShadowWritten(device, offset, dlen, 1, &buffer, NULL, status, "regDevPut");
         epicsMutexUnlock(device->accesslock);
     }
     else
@@ -3170,10 +6029,157 @@ static void regDevPutFunc (const iocshArgBuf *args)
         args[0].sval, args[1].ival, args[2].ival, args[3].ival);
 }
 
+static const iocshArg regDevStartAcquisitionArg0 = { "devName", iocshArgString };
+static const iocshArg regDevStartAcquisitionArg1 = { "period", iocshArgDouble };
+static const iocshArg regDevStartAcquisitionArg2 = { "priority", iocshArgInt };
+static const iocshArg regDevStartAcquisitionArg3 = { "cpu", iocshArgString };
+static const iocshArg * const regDevStartAcquisitionArgs[] = {
+    &regDevStartAcquisitionArg0,
+    &regDevStartAcquisitionArg1,
+    &regDevStartAcquisitionArg2,
+    &regDevStartAcquisitionArg3,
+};
+
+static const iocshFuncDef regDevStartAcquisitionDef =
+    { "regDevStartAcquisition", 4, regDevStartAcquisitionArgs };
+
+static void regDevStartAcquisitionFunc (const iocshArgBuf *args)
+{
+    regDevStartAcquisition(
+        args[0].sval, args[1].dval, args[2].ival, args[3].sval ? strtol(args[3].sval, NULL, 0) : -1);
+}
+
+static const iocshArg regDevBufferPolicyArg0 = { "devName", iocshArgString };
+static const iocshArg regDevBufferPolicyArg1 = { "hugepages", iocshArgString };
+static const iocshArg regDevBufferPolicyArg2 = { "numaNode", iocshArgString };
+static const iocshArg * const regDevBufferPolicyArgs[] = {
+    &regDevBufferPolicyArg0,
+    &regDevBufferPolicyArg1,
+    &regDevBufferPolicyArg2,
+};
+
+static const iocshFuncDef regDevBufferPolicyDef =
+    { "regDevBufferPolicy", 3, regDevBufferPolicyArgs };
+
+static void regDevBufferPolicyFunc (const iocshArgBuf *args)
+{
+    regDevBufferPolicy(
+        args[0].sval, args[1].sval, args[2].sval);
+}
+
+static const iocshArg regDevUpdateBackoffArg0 = { "devName", iocshArgString };
+static const iocshArg regDevUpdateBackoffArg1 = { "maxFactor", iocshArgDouble };
+static const iocshArg regDevUpdateBackoffArg2 = { "busyFraction", iocshArgDouble };
+static const iocshArg regDevUpdateBackoffArg3 = { "queueLimit", iocshArgInt };
+static const iocshArg * const regDevUpdateBackoffArgs[] = {
+    &regDevUpdateBackoffArg0,
+    &regDevUpdateBackoffArg1,
+    &regDevUpdateBackoffArg2,
+    &regDevUpdateBackoffArg3,
+};
+
+static const iocshFuncDef regDevUpdateBackoffDef =
+    { "regDevUpdateBackoff", 4, regDevUpdateBackoffArgs };
+
+static void regDevUpdateBackoffFunc (const iocshArgBuf *args)
+{
+    regDevUpdateBackoffPolicy(
+        args[0].sval, args[1].dval, args[2].dval, args[3].ival);
+}
+
+static const iocshArg regDevStartUpdateThreadsArg0 = { "devName", iocshArgString };
+static const iocshArg regDevStartUpdateThreadsArg1 = { "threads", iocshArgInt };
+static const iocshArg regDevStartUpdateThreadsArg2 = { "priority", iocshArgInt };
+static const iocshArg regDevStartUpdateThreadsArg3 = { "cpu", iocshArgString };
+static const iocshArg * const regDevStartUpdateThreadsArgs[] = {
+    &regDevStartUpdateThreadsArg0,
+    &regDevStartUpdateThreadsArg1,
+    &regDevStartUpdateThreadsArg2,
+    &regDevStartUpdateThreadsArg3,
+};
+
+static const iocshFuncDef regDevStartUpdateThreadsDef =
+    { "regDevStartUpdateThreads", 4, regDevStartUpdateThreadsArgs };
+
+static void regDevStartUpdateThreadsFunc (const iocshArgBuf *args)
+{
+    regDevStartUpdateThreads(
+        args[0].sval, args[1].ival, args[2].ival, args[3].sval ? strtol(args[3].sval, NULL, 0) : -1);
+}
+
+static const iocshArg regDevScanRateArg0 = { "devName", iocshArgString };
+static const iocshArg regDevScanRateArg1 = { "window", iocshArgDouble };
+static const iocshArg * const regDevScanRateArgs[] = {
+    &regDevScanRateArg0,
+    &regDevScanRateArg1,
+};
+
+static const iocshFuncDef regDevScanRateDef =
+    { "regDevScanRate", 2, regDevScanRateArgs };
+
+static void regDevScanRateFunc (const iocshArgBuf *args)
+{
+    regDevScanRate(
+        args[0].sval, args[1].dval);
+}
+
+static const iocshArg regDevBusyPollArg0 = { "devName", iocshArgString };
+static const iocshArg regDevBusyPollArg1 = { "priority", iocshArgInt };
+static const iocshArg regDevBusyPollArg2 = { "cpu", iocshArgString };
+static const iocshArg * const regDevBusyPollArgs[] = {
+    &regDevBusyPollArg0,
+    &regDevBusyPollArg1,
+    &regDevBusyPollArg2,
+};
+
+static const iocshFuncDef regDevBusyPollDef =
+    { "regDevBusyPoll", 3, regDevBusyPollArgs };
+
+static void regDevBusyPollFunc (const iocshArgBuf *args)
+{
+    regDevBusyPoll(
+        args[0].sval, args[1].ival, args[2].sval ? strtol(args[2].sval, NULL, 0) : -1);
+}
+
+static const iocshArg regDevShadowArg0 = { "devName", iocshArgString };
+static const iocshArg * const regDevShadowArgs[] = {
+    &regDevShadowArg0,
+};
+
+static const iocshFuncDef regDevShadowDef =
+    { "regDevShadow", 1, regDevShadowArgs };
+
+static void regDevShadowFunc (const iocshArgBuf *args)
+{
+    regDevShadow(
+        args[0].sval);
+}
+
+static const iocshArg regDevInitReportArg0 = { "slowest", iocshArgInt };
+static const iocshArg * const regDevInitReportArgs[] = {
+    &regDevInitReportArg0
+};
+
+static const iocshFuncDef regDevInitReportDef =
+    { "regDevInitReport", 1, regDevInitReportArgs };
+
+static void regDevInitReportFunc (const iocshArgBuf *args)
+{
+    regDevInitReport(args[0].ival);
+}
+
 static void regDevRegistrar ()
 {
     iocshRegister(&regDevDisplayDef, regDevDisplayFunc);
     iocshRegister(&regDevPutDef, regDevPutFunc);
+    iocshRegister(&regDevStartAcquisitionDef, regDevStartAcquisitionFunc);
+    iocshRegister(&regDevBufferPolicyDef, regDevBufferPolicyFunc);
+    iocshRegister(&regDevInitReportDef, regDevInitReportFunc);
+    iocshRegister(&regDevUpdateBackoffDef, regDevUpdateBackoffFunc);
+    iocshRegister(&regDevStartUpdateThreadsDef, regDevStartUpdateThreadsFunc);
+    iocshRegister(&regDevScanRateDef, regDevScanRateFunc);
+    iocshRegister(&regDevBusyPollDef, regDevBusyPollFunc);
+    iocshRegister(&regDevShadowDef, regDevShadowFunc);
 }
 
 epicsExportRegistrar(regDevRegistrar);
@@ -210,6 +210,78 @@ epicsShareFunc int regDevMakeBlockdevice(
     int swap,           /* any of REGDEV*SWAP* below */
     void* buffer);      /* NULL or buffer space provided by the driver */
 
+/*
+A driver for many identical channels may register them as one device
+and call regDevMakeFamily to address them as a device family: name[index].
+Member index (0 to count-1) starts at offset index*stride of the device.
+All members share one lock, one work queue and one block buffer and the
+driver is called with offsets of the whole device.
+*/
+epicsShareFunc int regDevMakeFamily(
+    regDevice* device,
+    unsigned int count,
+    size_t stride);
+
+/*
+A driver may call regDevEnableRangeNotify at initialization to let regDev
+handle "I/O Intr" of input records without interrupt vector by address.
+Afterwards the driver calls regDevNotifyRange whenever bytes offset to
+offset+len-1 of the device may have changed. Only the records reading
+from that range are scanned. Do not call it from interrupt context.
+*/
+epicsShareFunc int regDevEnableRangeNotify(
+    regDevice* device);
+
+epicsShareFunc int regDevNotifyRange(
+    regDevice* device,
+    size_t offset,
+    size_t len);
+
+/*
+A driver may call regDevEnableShadow at initialization to make regDev keep
+a copy of the device registers as written and read. Masked writes to
+registers with known content are merged with that copy and written
+unmasked, without read-modify-write in the hardware. Links with the W
+option read from the copy instead of the hardware.
+Not supported for block devices and devices without size.
+*/
+epicsShareFunc int regDevEnableShadow(
+    regDevice* device);
+
+/*
+A driver may call regDevScanIoRequest instead of scanIoRequest for its
+"I/O Intr" scan lists. If a scan window has been configured for the
+device (see regDevScanRate shell function), requests for the same scan
+list within the window are coalesced into one scan. Do not call it from
+interrupt context.
+*/
+epicsShareFunc int regDevScanIoRequest(
+    regDevice* device,
+    IOSCANPVT ioscanpvt);
+
+/*
+A driver of a block device may call regDevTriggerAcquisition, e.g. from
+its interrupt handler, to make the acquisition thread of the device (see
+regDevStartAcquisition shell function) read the block immediately.
+It takes no lock and only signals an event, thus it is safe in interrupt
+context once the acquisition thread has been started.
+Returns an error if the device is unknown or has no acquisition thread.
+*/
+epicsShareFunc int regDevTriggerAcquisition(
+    regDevice* device);
+
+/*
+A driver may call regDevSetTimestamp to report when the data of a read
+transfer has been acquired by the hardware. Call it in the read function
+before returning or before calling the completion callback and pass the
+user argument of that read call. Records with TSE=-2 get this time stamp,
+for block reads all records reading from the block.
+*/
+struct epicsTimeStamp;
+epicsShareFunc int regDevSetTimestamp(
+    regDevice* device,
+    const char* user,
+    const struct epicsTimeStamp* stamp);
 
 /* Use this global variable to control debugging messages */
 epicsShareExtern int regDevDebug;
@@ -35,6 +35,7 @@ long regDevInitRecordAai(aaiRecord* record)
     status = regDevIoParse((dbCommon*)record, &record->inp,
         record->ftvl==DBF_FLOAT || record->ftvl==DBF_DOUBLE ? TYPE_FLOAT : 0);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     record->nord = record->nelm;
     /* We can map the record directly into the blockBuffer if
        - we have a blockBuffer
@@ -50,7 +51,7 @@ long regDevInitRecordAai(aaiRecord* record)
         !priv->fifopacking &&
         !priv->interlace &&
 #if EPICSVER < 31501
-        !priv->offsetRecord &&
+        !(priv->ext && priv->ext->offsetRecord) &&
 #endif
         priv->offset + record->nelm * priv->dlen <= priv->device->size)
     {
@@ -86,7 +87,7 @@ long regDevReadAai(aaiRecord* record)
     }
     status = regDevReadArray((dbCommon*)record, record->nelm);
     record->nord = record->nelm;
-    if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == ASYNC_COMPLETION || status == REGDEV_UNCHANGED) return S_dev_success;
     if (status) return status;
     if (priv->data.buffer == record->bptr) return S_dev_success;
     /* convert to float/double */
@@ -127,6 +128,7 @@ long regDevInitRecordAao(aaoRecord* record)
     status = regDevIoParse((dbCommon*)record, &record->out,
         record->ftvl==DBF_FLOAT || record->ftvl==DBF_DOUBLE ? TYPE_FLOAT : 0);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     record->nord = record->nelm;
 
     /* We can map the record directly into the blockBuffer if
@@ -144,7 +146,7 @@ long regDevInitRecordAao(aaoRecord* record)
         !priv->fifopacking &&
         !priv->interlace &&
 #if EPICSVER < 31501
-        !priv->offsetRecord &&
+        !(priv->ext && priv->ext->offsetRecord) &&
 #endif
         (priv->rboffset == DONT_INIT || priv->rboffset == priv->offset) &&
         priv->offset + record->nelm * priv->dlen <= priv->device->size)
@@ -171,6 +173,7 @@ long regDevInitRecordAao(aaoRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return S_dev_success;
     status = regDevReadArray((dbCommon*)record, record->nelm);
+    if (status == ASYNC_COMPLETION) return S_dev_success; /* batched readback */
     if (status) return status;
     if (priv->data.buffer == record->bptr) return S_dev_success;
     /* convert to float/double */
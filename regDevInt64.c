@@ -32,7 +32,7 @@ long regDevReadInt64in(int64inRecord* record)
     int status;
 
     status = regDevReadNumber((dbCommon*)record, &record->val, NULL);
-    if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == ASYNC_COMPLETION || status == REGDEV_UNCHANGED) return S_dev_success;
     if (status) return status;
     return S_dev_success;
 }
@@ -63,7 +63,9 @@ long regDevInitRecordInt64out(int64outRecord* record)
     status = regDevInstallUpdateFunction((dbCommon*)record, regDevUpdateInt64out);
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return S_dev_success;
-    return regDevReadNumber((dbCommon*)record, &record->val, NULL);
+    status = regDevReadNumber((dbCommon*)record, &record->val, NULL);
+    if (status == ASYNC_COMPLETION) return S_dev_success; /* batched readback */
+    return status;
 }
 
 /* DELTA calculates the absolute difference between its arguments */
@@ -35,6 +35,7 @@ long regDevInitRecordLsi(lsiRecord* record)
     priv->L = record->sizv;
     status = regDevIoParse((dbCommon*)record, &record->inp, TYPE_STRING);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     status = regDevAssertType((dbCommon*)record, TYPE_STRING);
     if (status) return status;
     priv->data.buffer = record->val;
@@ -48,7 +49,7 @@ long regDevReadLsi(lsiRecord* record)
 
     status = regDevReadArray((dbCommon*)record, record->sizv);
     if (status == ASYNC_COMPLETION) return S_dev_success;
-    if (status) return status;
+    if (status && status != REGDEV_UNCHANGED) return status;
     /* we cannot assume that the string was terminated */
     end = memchr(record->val, 0, record->sizv);
     if (end) record->len = (epicsUInt32)(end - record->val);
@@ -88,6 +89,7 @@ long regDevInitRecordLso(lsoRecord* record)
     priv->L = record->sizv;
     status = regDevIoParse((dbCommon*)record, &record->out, TYPE_STRING);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     status = regDevAssertType((dbCommon*)record, TYPE_STRING);
     if (status) return status;
     priv->data.buffer = record->val;
@@ -95,6 +97,7 @@ long regDevInitRecordLso(lsoRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return S_dev_success;
     status = regDevReadArray((dbCommon*)record, record->sizv);
+    if (status == ASYNC_COMPLETION) return S_dev_success; /* batched readback */
     if (status) return status;
     end = memchr(record->val, 0, record->sizv);
     if (end) record->len = (epicsUInt32)(end - record->val);
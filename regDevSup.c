@@ -80,10 +80,7 @@ long regDevWriteUpdater(boRecord* record)
         return S_dev_badInit;
     }
     if (record->val)
-    {
-        priv = priv->device->triggeredUpdates;
-        if (priv) epicsTimerStartDelay(priv->updateTimer, 0.0);
-    }
+        return regDevTriggerUpdates(priv->device);
     return S_dev_success;
 }
 
@@ -119,6 +116,7 @@ long regDevReadBi(biRecord* record)
 
     status = regDevReadBits((dbCommon*)record, &rval);
     if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == REGDEV_UNCHANGED) return DONT_CONVERT;
     if (status) return status;
     if (record->mask) rval &= record->mask;
     record->rval = rval;
@@ -156,6 +154,7 @@ long regDevInitRecordBo(boRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return DONT_CONVERT;
     status = regDevReadBits((dbCommon*)record, &rval);
+    if (status == ASYNC_COMPLETION) return DONT_CONVERT; /* batched readback */
     if (status) return status;
     if (record->mask) rval &= record->mask;
     record->rval = rval;
@@ -242,6 +241,7 @@ long regDevReadMbbi(mbbiRecord* record)
 
     status = regDevReadBits((dbCommon*)record, &rval);
     if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == REGDEV_UNCHANGED) return DONT_CONVERT;
     if (status) return status;
     if (record->mask) rval &= record->mask;
     /* If any values defined write to RVAL field else to VAL field */
@@ -290,6 +290,7 @@ long regDevInitRecordMbbo(mbboRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return DONT_CONVERT;
     status = regDevReadBits((dbCommon*)record, &rval);
+    if (status == ASYNC_COMPLETION) return DONT_CONVERT; /* batched readback */
     if (status) return status;
     if (record->mask) rval &= record->mask;
     /* If any values defined write to RVAL field else to VAL field */
@@ -414,6 +415,7 @@ long regDevReadMbbiDirect(mbbiDirectRecord* record)
 
     status = regDevReadBits((dbCommon*)record, &rval);
     if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == REGDEV_UNCHANGED) return DONT_CONVERT;
     if (status) return status;
     if (record->mask) rval &= record->mask;
     record->rval = rval;
@@ -449,10 +451,11 @@ long regDevInitRecordMbboDirect(mbboDirectRecord* record)
     record->udf = 0;                   /* workaround for mbboDirect bug */
     record->mask <<= record->shft;
     priv->invert <<= record->shft;
-    regDevInstallUpdateFunction((dbCommon*)record, regDevUpdateMbboDirect);
+    status = regDevInstallUpdateFunction((dbCommon*)record, regDevUpdateMbboDirect);
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return DONT_CONVERT;
     status = regDevReadBits((dbCommon*)record, &rval);
+    if (status == ASYNC_COMPLETION) return DONT_CONVERT; /* batched readback */
     if (status) return status;
     if (record->mask) rval &= record->mask;
     record->rval = rval;
@@ -559,7 +562,7 @@ long regDevReadLongin(longinRecord* record)
     epicsInt64 val;
 
     status = regDevReadNumber((dbCommon*)record, &val, NULL);
-    if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == ASYNC_COMPLETION || status == REGDEV_UNCHANGED) return S_dev_success;
     if (status) return status;
     record->val = (epicsInt32)val;
     return S_dev_success;
@@ -594,6 +597,7 @@ long regDevInitRecordLongout(longoutRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return S_dev_success;
     status = regDevReadNumber((dbCommon*)record, &val, NULL);
+    if (status == ASYNC_COMPLETION) return S_dev_success; /* batched readback */
     if (status) return status;
     record->val = (epicsInt32)val;
     return S_dev_success;
@@ -686,6 +690,7 @@ long regDevReadAi(aiRecord* record)
     udf = record->udf;
     status = regDevReadNumber((dbCommon*)record, &rval, &val);
     if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == REGDEV_UNCHANGED) return DONT_CONVERT;
     if (status == S_dev_success)
     {
         record->rval = (epicsInt32)rval;
@@ -783,6 +788,7 @@ long regDevInitRecordAo(aoRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return DONT_CONVERT;
     status = regDevReadNumber((dbCommon*)record, &rval, &val);
+    if (status == ASYNC_COMPLETION) return DONT_CONVERT; /* batched readback */
     if (status == S_dev_success)
     {
         record->rval = (epicsInt32)rval;
@@ -971,6 +977,7 @@ long regDevInitRecordStringin(stringinRecord* record)
     priv->L = sizeof(record->val);
     status = regDevIoParse((dbCommon*)record, &record->inp, TYPE_STRING);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     status = regDevAssertType((dbCommon*)record, TYPE_STRING);
     if (status) return status;
     priv->data.buffer = record->val;
@@ -982,7 +989,7 @@ long regDevReadStringin(stringinRecord* record)
     int status;
 
     status = regDevReadArray((dbCommon*) record, sizeof(record->val));
-    if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == ASYNC_COMPLETION || status == REGDEV_UNCHANGED) return S_dev_success;
     return status;
 
 }
@@ -1019,6 +1026,7 @@ long regDevInitRecordStringout(stringoutRecord* record)
     priv->L = sizeof(record->val);
     status = regDevIoParse((dbCommon*)record, &record->out, TYPE_STRING);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     status = regDevAssertType((dbCommon*)record, TYPE_STRING);
     if (status) return status;
     priv->data.buffer = record->val;
@@ -1026,6 +1034,7 @@ long regDevInitRecordStringout(stringoutRecord* record)
     if (status) return status;
     if (priv->rboffset == DONT_INIT) return S_dev_success;
     status =  regDevReadArray((dbCommon*) record, sizeof(record->val));
+    if (status == ASYNC_COMPLETION) return S_dev_success; /* batched readback */
     if (status) return status;
     return S_dev_success;
 }
@@ -1095,17 +1104,49 @@ long regDevInitRecordWaveform(waveformRecord* record)
     status = regDevIoParse((dbCommon*)record, &record->inp,
         record->ftvl==DBF_FLOAT || record->ftvl==DBF_DOUBLE ? TYPE_FLOAT : 0);
     if (status) return status;
+    priv = (regDevPrivate*)record->dpvt;
     record->nord = record->nelm;
     priv->data.buffer = record->bptr;
     status = regDevCheckType((dbCommon*)record, record->ftvl, record->nelm);
-    if (status == ARRAY_CONVERT)
+#if EPICSVER >= 31501
+    /* We can map the raw data directly into the blockBuffer if
+       - we have a blockBuffer
+       - we do not need to modify the data (e.g by swapping)
+       - the data is no string (terminating null byte)
+       - the offset is constant
+       - we do not overflow the blockBuffer
+       Since EPICS 3.15.1 the record may change bptr.
+    */
+    if ((status == S_dev_success || status == ARRAY_CONVERT) &&
+        priv->device->blockBuffer &&
+        !priv->device->swap &&
+        priv->dtype < 100 &&  /* not a BCD type */
+        priv->dtype != epicsStringT &&
+        !priv->invert &&
+        !priv->mask &&
+        !priv->fifopacking &&
+        !priv->interlace &&
+        !(priv->ext && priv->ext->offsetRecord) &&
+        priv->offset + record->nelm * priv->dlen <= priv->device->size &&
+        priv->offset + record->nelm * dbValueSize(record->ftvl) <= priv->device->size)
     {
-        priv->data.buffer = calloc(1, record->nelm * priv->dlen);
-        if (!priv->data.buffer)
+        char* block = priv->device->blockBuffer + priv->offset;
+        if (status == S_dev_success)
         {
-            regDevPrintErr("out of memory");
-            return S_dev_noMemory;
+            /* map record directly in block buffer */
+            free(record->bptr);
+            record->bptr = block;
         }
+        /* else: only the raw data is mapped, scaling reads it from there */
+        priv->data.buffer = block;
+        regDevDebugLog(DBG_INIT, "%s: mapped into %s block buffer %p+0x%" Z "x\n",
+            record->name, priv->device->name, priv->device->blockBuffer, priv->offset);
+        return S_dev_success;
+    }
+#endif
+    if (status == ARRAY_CONVERT)
+    {
+        priv->data.buffer = regDevArenaAlloc(priv->device, record->nelm * priv->dlen);
         return S_dev_success;
     }
     return status;
@@ -1118,7 +1159,7 @@ long regDevReadWaveform(waveformRecord* record)
 
     status = regDevReadArray((dbCommon*) record, record->nelm);
     record->nord = record->nelm;
-    if (status == ASYNC_COMPLETION) return S_dev_success;
+    if (status == ASYNC_COMPLETION || status == REGDEV_UNCHANGED) return S_dev_success;
     if (status != S_dev_success) return status;
     if (priv->data.buffer != record->bptr)
     {
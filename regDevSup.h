@@ -14,6 +14,7 @@
 #include <epicsMutex.h>
 #include <epicsEvent.h>
 #include <epicsTimer.h>
+#include <epicsTime.h>
 
 #include <math.h>
 #include <sys/types.h>
@@ -43,26 +44,66 @@ typedef unsigned long long epicsUInt64;
 
 #define ARRAY_CONVERT 1
 #define DONT_CONVERT 2
+#define REGDEV_UNCHANGED 3  /* read with D=: input unchanged, keep value */
 
 typedef struct regDevDispatcher regDevDispatcher;
+typedef struct regDevAcquisition regDevAcquisition;
+
+/* phases of init profiling */
+#define REGDEV_INIT_PARSE    0
+#define REGDEV_INIT_LOOKUP   1
+#define REGDEV_INIT_ALLOC    2
+#define REGDEV_INIT_READBACK 3
+#define REGDEV_INIT_UPDATER  4
+#define REGDEV_INIT_BATCH    5
+#define REGDEV_INIT_PHASES   6
 
 typedef struct regDeviceNode {                     /* per device data structure */
     epicsUInt32 magic;
     struct regDeviceNode* next;                    /* Next registered device */
     const char* name;                              /* Device name */
     size_t size;                                   /* Device size in bytes */
+    unsigned int familyCount;                      /* Members of device family */
+    size_t familyStride;                           /* Offset from one member to the next */
     const regDevSupport* support;                  /* Device function table */
     regDevice* driver;                             /* Generic device driver */
     epicsMutexId accesslock;                       /* Access semaphore */
+    epicsMutexId stampLock;                        /* Protects driver time stamps */
+    struct gphPvt* stamps;                         /* Driver time stamps by user */
     void* (*dmaAlloc) (regDevice*, void*, size_t); /* DMA memory allocator */
+    size_t hugepageSize;                           /* Buffer policy without dmaAlloc */
+    int numaNode;
+    struct regDevMapping* mappings;                /* Buffers allocated with policy */
     regDevDispatcher* dispatcher;                  /* Serialize requests */
     epicsTimerQueueId updateTimerQueue;            /* For update timers */
+    epicsTimerQueueId* updateThreads;              /* Dedicated update timer queues */
+    unsigned int updateThreadCount;
     char* blockBuffer;                             /* For block mode */
+    int blockBufferAllocated;                      /* blockBuffer allocated by regDev */
+    volatile epicsUInt32 blockSeq;                 /* Odd while blockBuffer is updated */
+    int blockWriters;                              /* Updates of blockBuffer in progress */
+    epicsTimeStamp blockTime;                      /* When blockBuffer was updated */
+    regDevAcquisition* acquisition;                /* Block acquisition thread */
     int blockModes;
     int swap;                                      /* Data swap mode */
     IOSCANPVT blockReceived;
     IOSCANPVT blockSent;
-    struct regDevPrivate* triggeredUpdates;        /* For triggered update */
+    unsigned long skippedInputs;                   /* Unchanged inputs not converted */
+    struct regDevRangeNotify* rangeNotify;         /* I/O Intr by address range */
+    struct regDevScanRate* scanRate;               /* Coalesce I/O Intr scans */
+    struct regDevShadow* shadow;                   /* Copy of written registers */
+    struct regDevUpdateGroup* updateGroups;        /* For periodic and triggered update */
+    double updateMaxFactor;                        /* Update backoff: max period stretch */
+    double updateBusyFraction;                     /* Back off if reads take longer */
+    unsigned int updateQueueLimit;                 /* Back off at this many queued requests */
+    struct regDevInitRead* initReads;              /* Deferred readbacks at init */
+    size_t initReadCount;
+    struct regDevInitBuffer* initBuffers;
+    epicsEventId initDone;                         /* For parallel init */
+    struct regDevArena* arena;                     /* Per record data and buffers */
+    void* freePrivs;                               /* Arena slots of records that failed init */
+    double initTime[REGDEV_INIT_PHASES];           /* Init profiling */
+    unsigned long initRecords;
 } regDeviceNode;
 
 typedef union {
@@ -79,32 +120,48 @@ typedef union {
     void* buffer;
 } regDevAnytype;
 
-typedef struct regDevPrivate {         /* per record data structure */
-    epicsUInt32 magic;
-    regDeviceNode* device;
-    size_t offset;                     /* Offset (in bytes) within device memory */
-    size_t rboffset;                   /* Offset to read back output records (or DONT_INIT) */
+typedef struct regDevPrivateExt {      /* rarely used per record data */
     struct dbAddr* offsetRecord;       /* Record to read offset from */
     ptrdiff_t offsetScale;             /* Scaling of value from offsetRecord */
-    epicsUInt8 bit;                    /* Bit number (0-15) for bi/bo */
+    DEVSUPFUN updater;                 /* Update function */
+    epicsInt32 update;                 /* Periodic update of output records (msec) */
+    struct regDevUpdateGroup* group;   /* For periodic or triggered update */
+    char* updateData;                  /* Data read by group or NULL */
+    size_t updateOffset;               /* Learned transfer of update */
+    size_t updateNelem;
+    size_t updateDataOffset;           /* Position in group buffer */
+    int updateRange;                   /* Group transfer or -1 */
+    epicsUInt8 updateDlen;
+    epicsUInt8 lastRawValid;           /* lastRaw holds the last update */
+    char* lastRaw;                     /* Raw data of last update or input */
+    size_t lastRawSize;
+    epicsUInt8 deadbandSet;            /* Input keeps value unless changed */
+    epicsUInt8 writeOnly;              /* Read from shadow, never from hardware */
+    double deadband;                   /* Raw deadband of scalar input */
+} regDevPrivateExt;
+
+typedef struct regDevPrivate {         /* per record data structure */
+    /* used in every processing, keep together */
+    epicsUInt32 magic;
     epicsUInt8 dtype;                  /* Data type */
     epicsUInt8 dlen;                   /* Data length (in bytes) */
+    epicsUInt8 bit;                    /* Bit number (0-15) for bi/bo */
     epicsUInt8 fifopacking;            /* Fifo: elelents in one register */
-    epicsInt32 update;                 /* Periodic update of output records (msec) */
+    regDeviceNode* device;
+    size_t offset;                     /* Offset (in bytes) within device memory */
+    int status;                        /* For asynchonous drivers */
+    int updating;                      /* Processing type */
+    regDevAnytype data;                /* For asynchonous drivers and arrays */
+    size_t asyncOffset;                /* For asynchonous drivers */
+    size_t nelm;                       /* Array size */
     epicsInt64 L;                      /* Hardware Low limit */
     epicsInt64 H;                      /* Hardware High limit */
     epicsUInt64 invert;                /* Invert bits */
     epicsUInt64 mask;                  /* Mask bits */
-    DEVSUPFUN updater;                 /* Update function */
-    epicsTimerId updateTimer;          /* Update timer */
-    int updating;                      /* Processing type */
-    struct regDevPrivate* nextUpdate;  /* For triggered update */
-    int status;                        /* For asynchonous drivers */
-    size_t asyncOffset;                /* For asynchonous drivers */
-    regDevAnytype data;                /* For asynchonous drivers and arrays */
-    epicsInt32 irqvec;                 /* Interrupt vector for I/O Intr */
-    size_t nelm;                       /* Array size */
     ptrdiff_t interlace;               /* Relative offset of next array element */
+    size_t rboffset;                   /* Offset to read back output records (or DONT_INIT) */
+    regDevPrivateExt* ext;             /* NULL unless rarely used features are used */
+    epicsInt32 irqvec;                 /* Interrupt vector for I/O Intr */
 } regDevPrivate;
 
 struct devsup {
@@ -120,13 +177,17 @@ long regDevInit(int finished);
 long regDevGetInIntInfo(int cmd, dbCommon *record, IOSCANPVT *ppvt);
 long regDevGetOutIntInfo(int cmd, dbCommon *record, IOSCANPVT *ppvt);
 regDevPrivate* regDevAllocPriv(dbCommon *record);
+regDevPrivateExt* regDevAllocPrivExt(regDevPrivate* priv);
 int regDevCheckFTVL(dbCommon* record, int ftvl);
-int regDevIoParse(dbCommon* record, struct link* link, int types);
+int regDevIoParse(dbCommon* record, struct link* link, int types); /* may move record->dpvt */
 int regDevCheckType(dbCommon* record, int ftvl, int nelm);
 int regDevAssertType(dbCommon *record, int types);
 const char* regDevTypeName(unsigned short dtype);
 int regDevMemAlloc(dbCommon* record, void** bptr, size_t size);
+int regDevAllocBuffer(regDeviceNode* device, const char* name, void** bptr, size_t size);
+void* regDevArenaAlloc(regDeviceNode* device, size_t size); /* at init only, never freed */
 int regDevInstallUpdateFunction(dbCommon* record, DEVSUPFUN updater);
+int regDevTriggerUpdates(regDeviceNode* device);
 
 /* returns OK, ERROR, or ASYNC_COMPLETION */
 /* here buffer must not point to local variable! */
@@ -153,6 +214,7 @@ int regDevScaleToRaw(dbCommon* record, int ftvl, void* rval, size_t nelm, double
     if (!priv) return S_dev_noMemory; \
     status = regDevIoParse((dbCommon*)record, &record->link, types); \
     if (status) return status; \
+    priv = (regDevPrivate*)record->dpvt; \
     status = regDevAssertType((dbCommon*)record, types); \
     if (status) return status
 
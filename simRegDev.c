@@ -50,6 +50,7 @@ struct regDevice {
     int swap;
     int connected;
     int blockDevice;
+    int rangeNotify;
     IOSCANPVT ioscanpvt;
     epicsMutexId lock;
     epicsTimerQueueId queue[NUM_CALLBACK_PRIORITIES];
@@ -58,6 +59,15 @@ struct regDevice {
 };
 
 int simRegDevDebug = 0;
+
+/* scan the input records interested in new data */
+static void simRegDevTrigger(regDevice* device, size_t offset, size_t len)
+{
+    if (device->rangeNotify)
+        regDevNotifyRange(device, offset, len);
+    else
+        regDevScanIoRequest(device, device->ioscanpvt);
+}
 epicsExportAddress(int, simRegDevDebug);
 
 /******** async processing *****************************/
@@ -148,7 +158,7 @@ void simRegDevCallback(void* arg)
         /* We got new data: trigger all interested input records */
         if (simRegDevDebug & DBG_OUT)
             printf ("simRegDevCallback %s %s: trigger input records\n", msg->user, device->name);
-        scanIoRequest(device->ioscanpvt);
+        simRegDevTrigger(device, (unsigned char*)msg->dest - device->buffer, msg->dlen * msg->nelem);
     }
     epicsMutexUnlock(device->lock);
     if (simRegDevDebug & (msg->isOutput ? DBG_OUT : DBG_IN))
@@ -302,7 +312,7 @@ int simRegDevWrite(
     /* We got new data: trigger all interested input records */
     if (simRegDevDebug & DBG_OUT)
         printf ("simRegDevWrite %s: trigger input records\n", device->name);
-    scanIoRequest(device->ioscanpvt);
+    simRegDevTrigger(device, offset, dlen * nelem);
     return S_dev_success;
 }
 
@@ -321,13 +331,14 @@ int simRegDevConfigure(
     size_t size,
     int swapEndianFlag,
     int async,
-    int blockDevice)
+    int blockDevice,
+    int rangeNotify)
 {
     regDevice* device;
 
     if (name == NULL)
     {
-        printf("usage: simRegDevConfigure(\"name\", size, swapEndianFlag)\n");
+        printf("usage: simRegDevConfigure(\"name\", size, swapEndianFlag, blockDevice, rangeNotify)\n");
         printf("maps allocated memory block to device \"name\"");
         printf("\"name\" must be a unique string on this IOC\n");
         return S_dev_success;
@@ -357,6 +368,11 @@ int simRegDevConfigure(
         }
     }
     regDevRegisterDevice(name, &simRegDevSupport, device, size);
+    if (rangeNotify)
+    {
+        /* records without interrupt vector are scanned when their data changes */
+        device->rangeNotify = regDevEnableRangeNotify(device) == S_dev_success;
+    }
     device->blockDevice = blockDevice;
     if (blockDevice)
         regDevMakeBlockdevice(device, REGDEV_BLOCK_READ | REGDEV_BLOCK_WRITE, REGDEV_NO_SWAP, device->buffer);
@@ -368,9 +384,10 @@ int simRegDevAsyncConfigure(
     const char* name,
     size_t size,
     int swapEndianFlag,
-    int blockFlag)
+    int blockFlag,
+    int rangeNotify)
 {
-    return simRegDevConfigure(name, size, swapEndianFlag, 1, blockFlag);
+    return simRegDevConfigure(name, size, swapEndianFlag, 1, blockFlag, rangeNotify);
 }
 
 int simRegDevSetStatus(
@@ -402,7 +419,7 @@ int simRegDevSetStatus(
     device->connected = connected;
     if (simRegDevDebug >= 1)
         printf ("simRegDevSetStatus %s: trigger input records\n", device->name);
-    scanIoRequest(device->ioscanpvt);
+    simRegDevTrigger(device, 0, device->size);
     return S_dev_success;
 }
 
@@ -444,7 +461,7 @@ int simRegDevSetData(
     device->buffer[offset] = value;
     if (simRegDevDebug >= 1)
         printf ("simRegDevSetData %s: trigger input records\n", device->name);
-    scanIoRequest(device->ioscanpvt);
+    simRegDevTrigger(device, offset, 1);
     return S_dev_success;
 }
 
@@ -494,30 +511,32 @@ static const iocshArg simRegDevConfigureArg0 = { "name", iocshArgString };
 static const iocshArg simRegDevConfigureArg1 = { "size", iocshArgInt };
 static const iocshArg simRegDevConfigureArg2 = { "swapEndianFlag", iocshArgInt };
 static const iocshArg simRegDevConfigureArg3 = { "blockDevice", iocshArgInt };
+static const iocshArg simRegDevConfigureArg4 = { "rangeNotify", iocshArgInt };
 static const iocshArg * const simRegDevConfigureArgs[] = {
     &simRegDevConfigureArg0,
     &simRegDevConfigureArg1,
     &simRegDevConfigureArg2,
-    &simRegDevConfigureArg3
+    &simRegDevConfigureArg3,
+    &simRegDevConfigureArg4
 };
 
 static const iocshFuncDef simRegDevConfigureDef =
-    { "simRegDevConfigure", 4, simRegDevConfigureArgs };
+    { "simRegDevConfigure", 5, simRegDevConfigureArgs };
 
 static void simRegDevConfigureFunc (const iocshArgBuf *args)
 {
     int status = simRegDevConfigure(
-        args[0].sval, args[1].ival, args[2].ival, 0, args[3].ival);
+        args[0].sval, args[1].ival, args[2].ival, 0, args[3].ival, args[4].ival);
     if (status != 0) epicsExit(1);
 }
 
 static const iocshFuncDef simRegDevAsyncConfigureDef =
-    { "simRegDevAsyncConfigure", 4, simRegDevConfigureArgs };
+    { "simRegDevAsyncConfigure", 5, simRegDevConfigureArgs };
 
 static void simRegDevAsyncConfigureFunc (const iocshArgBuf *args)
 {
     int status = simRegDevAsyncConfigure(
-        args[0].sval, args[1].ival, args[2].ival, args[3].ival);
+        args[0].sval, args[1].ival, args[2].ival, args[3].ival, args[4].ival);
     if (status != 0) epicsExit(1);
 }
 
@@ -3,7 +3,8 @@ int simRegDevConfigure(
     size_t size,
     int swapEndianFlag,
     int async,
-    int blockDevice);
+    int blockDevice,
+    int rangeNotify);
 
 int simRegDevSetStatus(
     const char* name,
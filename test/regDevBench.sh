@@ -0,0 +1,156 @@
+#!/bin/sh
+# Benchmark of regDev initialization with many records on simRegDev devices.
+# This file uses PSI tools (iocsh with require), like testRegDev.script.
+#
+# usage: regDevBench.sh [options] [-- additional iocsh arguments]
+#   -n records    number of records (default 100000)
+#   -d devices    number of simRegDev devices (default 16)
+#   -b devices    how many of them are block devices (default 4)
+#   -m mix        record mix as type=weight,... (default ai=4,ao=4,bi=2,bo=2,waveform=1,aai=1)
+#   -o dir        output directory (default regDevBench.out)
+#   -s cmd        iocsh command executed before iocInit, e.g. "var regDevBatchInit 1"
+#                 (may be given multiple times)
+#   -g            only generate the files, do not run the IOC
+#
+# The generated database uses output records with readback (ao, bo) so that
+# readbacks are part of the measurement and take the batched path with
+# regDevBatchInit or regDevParallelInit (on non-block devices). The same
+# records are also loaded without device support in a separate IOC, which
+# is subtracted from init time and memory growth to get the share of regDev.
+# Results are printed at the end: init time, memory growth per record,
+# regDevInitReport and dbior output.
+
+records=100000
+devices=16
+blockdevices=4
+mix="ai=4,ao=4,bi=2,bo=2,waveform=1,aai=1"
+out=regDevBench.out
+generateonly=
+setup=
+
+while getopts n:d:b:m:o:s:g opt
+do
+    case $opt in
+        n) records=$OPTARG ;;
+        d) devices=$OPTARG ;;
+        b) blockdevices=$OPTARG ;;
+        m) mix=$OPTARG ;;
+        o) out=$OPTARG ;;
+        s) setup="$setup$OPTARG
+" ;;
+        g) generateonly=1 ;;
+        *) sed -n '3,17s/^# \{0,1\}//p' "$0"; exit 1 ;;
+    esac
+done
+shift $((OPTIND-1))
+
+mkdir -p "$out" || exit 1
+
+# Each record uses a 64 byte slot in its device.
+slot=64
+perdevice=$(( (records + devices - 1) / devices ))
+size=$(( perdevice * slot ))
+
+# soft=1 generates the baseline: same records without device support
+generate() {
+awk -v records="$records" -v devices="$devices" -v mix="$mix" -v slot="$slot" -v soft="$1" '
+BEGIN {
+    n = split(mix, m, ",")
+    total = 0
+    for (i = 1; i <= n; i++) {
+        split(m[i], tw, "=")
+        type[i] = tw[1]
+        total += tw[2]
+        limit[i] = total
+    }
+    for (r = 0; r < records; r++) {
+        # spread types evenly over the records
+        w = (r * 7919) % total
+        for (i = 1; limit[i] <= w; i++);
+        t = type[i]
+        dev = "bench" (r % devices)
+        off = int(r / devices) * slot
+        name = "BENCH:" t ":" r
+        printf "record (%s, \"%s\")\n{\n", t, name
+        if (soft) {
+            if (t == "waveform" || t == "aai" || t == "aao")
+                printf "    field (FTVL, \"SHORT\")\n    field (NELM, \"16\")\n"
+            printf "}\n"
+            continue
+        }
+        printf "    field (DTYP, \"regDev\")\n"
+        if (t == "ai")
+            printf "    field (INP,  \"@%s:%d T=INT16\")\n", dev, off
+        else if (t == "ao")
+            printf "    field (OUT,  \"@%s:%d: T=INT16\")\n", dev, off
+        else if (t == "bi" || t == "mbbi" || t == "longin")
+            printf "    field (INP,  \"@%s:%d T=INT8\")\n", dev, off
+        else if (t == "bo" || t == "mbbo" || t == "longout")
+            printf "    field (OUT,  \"@%s:%d: T=INT8\")\n", dev, off
+        else if (t == "waveform" || t == "aai")
+            printf "    field (INP,  \"@%s:%d T=INT16\")\n    field (FTVL, \"SHORT\")\n    field (NELM, \"16\")\n", dev, off
+        else if (t == "aao")
+            printf "    field (OUT,  \"@%s:%d: T=INT16\")\n    field (FTVL, \"SHORT\")\n    field (NELM, \"16\")\n", dev, off
+        else {
+            print "unsupported record type " t > "/dev/stderr"
+            exit 1
+        }
+        printf "}\n"
+    }
+}'
+}
+generate 0 > "$out/bench.db" || exit 1
+generate 1 > "$out/soft.db" || exit 1
+
+{
+    i=0
+    while [ $i -lt "$devices" ]
+    do
+        block=0
+        [ $i -lt "$blockdevices" ] && block=1
+        echo "simRegDevConfigure bench$i,$size,0,$block"
+        i=$((i+1))
+    done
+    echo "var regDevInitProfile 1"
+    printf "%s" "$setup"
+    echo 'system "grep VmRSS /proc/$PPID/status | sed s/^/LOAD-/"'
+    echo "dbLoadRecords $out/bench.db"
+    echo 'system "date +INIT-START:%s.%N"'
+    echo "iocInit"
+    echo 'system "date +INIT-END:%s.%N"'
+    echo 'system "grep VmRSS /proc/$PPID/status | sed s/^/INIT-/"'
+    echo "regDevInitReport 20"
+    echo 'dbior "regDev",1'
+    echo "exit"
+} > "$out/bench.cmd"
+
+{
+    echo 'system "grep VmRSS /proc/$PPID/status | sed s/^/LOAD-/"'
+    echo "dbLoadRecords $out/soft.db"
+    echo 'system "date +INIT-START:%s.%N"'
+    echo "iocInit"
+    echo 'system "date +INIT-END:%s.%N"'
+    echo 'system "grep VmRSS /proc/$PPID/status | sed s/^/INIT-/"'
+    echo "exit"
+} > "$out/soft.cmd"
+
+echo "generated $records records on $devices devices ($blockdevices block) in $out"
+[ -n "$generateonly" ] && exit 0
+
+iocsh -r regDev "$@" "$out/bench.cmd" > "$out/bench.log" 2>&1
+iocsh -r regDev "$@" "$out/soft.cmd" > "$out/soft.log" 2>&1
+
+awk -v records="$records" '
+/^LOAD-VmRSS/ { before[FILENAME] = $2 }
+/^INIT-VmRSS/ { after[FILENAME] = $2 }
+/^INIT-START/ { split($0, a, ":"); start[FILENAME] = a[2] }
+/^INIT-END/   { split($0, a, ":"); end[FILENAME] = a[2] }
+END {
+    b = ARGV[1]; s = ARGV[2]
+    time = (end[b] - start[b]) - (end[s] - start[s])
+    mem = (after[b] - before[b]) - (after[s] - before[s])
+    printf "iocInit time:     %.3f s (%.3f s without regDev)\n", time, end[s] - start[s]
+    printf "memory growth:    %d KiB (%d KiB without regDev)\n", mem, after[s] - before[s]
+    if (records) printf "memory/record:    %.0f bytes\n", mem * 1024 / records
+}' "$out/bench.log" "$out/soft.log"
+sed -n '/^ *records *total/,$p' "$out/bench.log"
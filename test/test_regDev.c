@@ -21,6 +21,12 @@ int main (int argc, char** argv)
     printf ("test_regDevWriteNumber\n");
     test_regDevWriteNumber();
 
+    printf ("test_regDevShadow\n");
+    test_regDevShadow();
+
+    printf ("test_regDevDeadband\n");
+    test_regDevDeadband();
+
     printf("%d error%s\n", errorcount, errorcount==1?"":"s");
     return 0;
 }
@@ -4,4 +4,6 @@
 extern int test_regDevCopy();
 extern int test_regDevIoParse();
 extern int test_regDevWriteNumber();
+extern int test_regDevShadow();
+extern int test_regDevDeadband();
 extern int errorcount;
@@ -0,0 +1,77 @@
+#include <string.h>
+#include <stdlib.h>
+#include <devLib.h>
+#include "epicsTypes.h"
+#include "regDevSup.h"
+#include "test_regDev.h"
+#include "simRegDev.h"
+
+static void initRecord(struct dbCommon* record, const char* name, const char* link)
+{
+    struct link l;
+
+    memset(record, 0, sizeof(*record));
+    strcpy(record->name, name);
+    memset(&l, 0, sizeof(l));
+    l.type = INST_IO;
+    l.value.instio.string = (char*)link;
+    regDevAllocPriv(record);
+    if (regDevIoParse(record, &l, TYPE_INT) != S_dev_success)
+    {
+        printf ("%s " FAILED ": cannot parse \"%s\"\n", name, link);
+        errorcount++;
+    }
+}
+
+static void check(struct dbCommon* record, int value, int expected)
+{
+    epicsUInt8 buffer[4];
+    int status;
+
+    simRegDevSetData("deadband", 0, value);
+    status = regDevRead(record, 1, record->name[0] == 'a' ? 4 : 1, buffer);
+    if (status != expected)
+    {
+        printf ("%s read 0x%02x " FAILED ": status %d instead of %d\n",
+            record->name, value, status, expected);
+        errorcount++;
+    }
+    else
+        printf ("%s read 0x%02x " PASSED " %s\n", record->name, value,
+            status == REGDEV_UNCHANGED ? "unchanged" : status ? "error" : "changed");
+}
+
+int test_regDevDeadband()
+{
+    struct dbCommon scalar, masked, array;
+
+    simRegDevConfigure ("deadband",16,0,0,0,0);
+    initRecord(&scalar, "scalar", "deadband:0 T=uint8 D=2");
+    initRecord(&masked, "masked", "deadband:0 T=uint8 M=0xf0 D=0");
+    initRecord(&array, "array", "deadband:0 T=uint8 D=0");
+    if (!scalar.dpvt || !masked.dpvt || !array.dpvt) return errorcount;
+
+    /* D= only applies once the IOC is running */
+    regDevInit(1);
+
+    check(&scalar, 100, S_dev_success);
+    check(&scalar, 101, REGDEV_UNCHANGED);
+    check(&scalar, 98, REGDEV_UNCHANGED);
+    check(&scalar, 103, S_dev_success);
+    check(&scalar, 104, REGDEV_UNCHANGED);
+
+    check(&masked, 0x10, S_dev_success);
+    check(&masked, 0x1f, REGDEV_UNCHANGED);
+    check(&masked, 0x2f, S_dev_success);
+
+    check(&array, 1, S_dev_success);
+    check(&array, 1, REGDEV_UNCHANGED);
+    check(&array, 2, S_dev_success);
+
+    /* a failed read is no input to compare with */
+    simRegDevSetStatus("deadband", 0);
+    check(&array, 3, S_dev_noDevice);
+    simRegDevSetStatus("deadband", 1);
+    check(&array, 3, S_dev_success);
+    return errorcount;
+}
@@ -92,10 +92,39 @@ parameters[] = {
 { "dev1 T=BCD32",
     S_dev_success,           0,      -1,  regDevBCD32T,   4,           0,   99999999,    0,     0  },
 
+{ "fam[2]:0x10",
+    S_dev_success,        0x50,      -1,  epicsInt16T,    2,     -0x7fff,     0x7fff,    0,     0  },
+{ "fam[1]:4:",
+    S_dev_success,        0x24,    0x24,  epicsInt16T,    2,     -0x7fff,     0x7fff,    0,     0  },
+{ "fam[1]:4:8 T=INT8",
+    S_dev_success,        0x24,    0x28,  epicsInt8T,     1,       -0x7f,       0x7f,    0,     0  },
+{ "fam[1+2]:0x1f T=UINT8",
+    S_dev_success,        0x7f,      -1,  epicsUInt8T,    1,           0,       0xff,    0,     0  },
+{ "dev1:0x10 D=5",
+    S_dev_success,        0x10,      -1,  epicsInt16T,    2,     -0x7fff,     0x7fff,    0,     0  },
+{ "shd:0x10 W",
+    S_dev_success,        0x10,      -1,  epicsInt16T,    2,     -0x7fff,     0x7fff,    0,     0  },
+{ "shd:0x10: T=UINT8 W",
+    S_dev_success,        0x10,      -1,  epicsUInt8T,    1,           0,       0xff,    0,     0  },
+
 { "dev2/42",
     S_dev_noDevice,          0,       0,  0,               0,          0,          0,    0,     0  },
 { "dev1/-5",
     S_dev_badArgument,      -5,      -1,  epicsInt16T,   2,      -0x7fff,     0x7fff,    0,     0  },
+{ "fam[4]:0",
+    S_dev_badSignalNumber,   0,       0,  0,               0,          0,          0,    0,     0  },
+{ "fam[1]:0x20",
+    S_dev_badSignalNumber,   0,       0,  0,               0,          0,          0,    0,     0  },
+{ "fam[1]:4:0x20",
+    S_dev_badSignalNumber,   0,       0,  0,               0,          0,          0,    0,     0  },
+{ "fam[1:4",
+    S_dev_badArgument,       0,       0,  0,               0,          0,          0,    0,     0  },
+{ "dev1[0]:4",
+    S_dev_wrongDevice,       0,       0,  0,               0,          0,          0,    0,     0  },
+{ "dev1:0x10 D=-1",
+    S_dev_badArgument,       0,       0,  0,               0,          0,          0,    0,     0  },
+{ "dev1:0x10 W",
+    S_dev_badArgument,       0,       0,  0,               0,          0,          0,    0,     0  },
 };    
 
 int test_regDevIoParse()
@@ -115,13 +144,16 @@ int test_regDevIoParse()
     link.type = INST_IO;
     link.value.instio.string = malloc(80);
     
-    simRegDevConfigure ("dev1",100,0,0,0);
+    simRegDevConfigure ("dev1",100,0,0,0,0);
+    simRegDevConfigure ("fam",0x80,0,0,0,0);
+    regDevMakeFamily(regDevFind("fam"), 4, 0x20);
+    simRegDevConfigure ("shd",100,0,0,0,0);
+    regDevEnableShadow(regDevFind("shd"));
     
     for (i = 0; i < sizeof(parameters)/sizeof(parameters[0]); i++)
     {
         printf("parse \"%s\" ", parameters[i].string); fflush(stdout);
         strcpy(link.value.instio.string, parameters[i].string);
-        free(record.dpvt);
         record.dpvt = NULL;
         if ((priv = regDevAllocPriv(&record)) == NULL)
         {
@@ -129,7 +161,8 @@ int test_regDevIoParse()
             errorcount++;
             continue;
         }
-        result = regDevIoParse(&record, &link);
+        result = regDevIoParse(&record, &link, TYPE_INT|TYPE_FLOAT|TYPE_STRING|TYPE_BCD);
+        priv = record.dpvt;
         if (result != parameters[i].result)
         {
             errSymLookup(result, errormessage, sizeof(errormessage));
@@ -0,0 +1,112 @@
+#include <string.h>
+#include <stdlib.h>
+#include <devLib.h>
+#include "epicsTypes.h"
+#include "regDevSup.h"
+#include "test_regDev.h"
+
+/* a driver that completes writes asynchronously only when told so */
+
+struct regDevice {
+    epicsUInt8 reg[16];
+    int async;
+    int masked;
+};
+
+static int shadowTestWrite(regDevice* device, size_t offset, unsigned int dlen, size_t nelem,
+    void* pdata, void* pmask, int prio, regDevTransferComplete callback, const char* user)
+{
+    size_t i;
+
+    for (i = 0; i < dlen * nelem; i++)
+    {
+        epicsUInt8 m = pmask ? ((epicsUInt8*)pmask)[i % dlen] : 0xff;
+        device->reg[offset + i] = (device->reg[offset + i] & ~m) | (((epicsUInt8*)pdata)[i] & m);
+    }
+    device->masked = pmask != NULL;
+    return device->async ? ASYNC_COMPLETION : S_dev_success;
+}
+
+static regDevSupport shadowTestSupport = {
+    NULL, NULL, NULL, NULL, shadowTestWrite
+};
+
+static void initRecord(struct dbCommon* record, const char* name, const char* link)
+{
+    struct link l;
+
+    memset(record, 0, sizeof(*record));
+    strcpy(record->name, name);
+    memset(&l, 0, sizeof(l));
+    l.type = INST_IO;
+    l.value.instio.string = (char*)link;
+    regDevAllocPriv(record);
+    if (regDevIoParse(record, &l, TYPE_INT) != S_dev_success)
+    {
+        printf ("%s " FAILED ": cannot parse \"%s\"\n", name, link);
+        errorcount++;
+    }
+}
+
+/* second call of the record after the driver has finished */
+static void complete(struct dbCommon* record, int status)
+{
+    ((regDevPrivate*)record->dpvt)->status = status;
+    regDevWriteNumber(record, 0, 0.0);
+    record->pact = 0;
+}
+
+static void check(const char* what, int ok)
+{
+    if (ok)
+        printf ("%s " PASSED "\n", what);
+    else
+    {
+        printf ("%s " FAILED "\n", what);
+        errorcount++;
+    }
+}
+
+int test_regDevShadow()
+{
+    static regDevice driver;
+    struct dbCommon low, high, readback;
+    epicsInt64 rval = 0;
+
+    regDevRegisterDevice("shadowtest", &shadowTestSupport, &driver, sizeof(driver.reg));
+    regDevEnableShadow(&driver);
+    initRecord(&low, "low", "shadowtest/0 T=uint8 M=0x0f");
+    initRecord(&high, "high", "shadowtest/0 T=uint8 M=0xf0");
+    initRecord(&readback, "readback", "shadowtest/0 T=uint8 W");
+    if (!low.dpvt || !high.dpvt || !readback.dpvt) return errorcount;
+
+    /* two overlapping masked writes in flight, the second finishes first */
+    driver.async = 1;
+    check("masked async write low", regDevWriteNumber(&low, 0x05, 0.0) == ASYNC_COMPLETION);
+    check("masked async write high", regDevWriteNumber(&high, 0x30, 0.0) == ASYNC_COMPLETION);
+    complete(&high, S_dev_success);
+    check("only completed bits known",
+        regDevReadNumber(&readback, &rval, NULL) != S_dev_success);
+    complete(&low, S_dev_success);
+    rval = 0;
+    check("both writes completed",
+        regDevReadNumber(&readback, &rval, NULL) == S_dev_success && rval == 0x35);
+
+    /* no merge with bits that another write is changing */
+    regDevWriteNumber(&low, 0x0a, 0.0);
+    check("merge with known bits", !driver.masked);
+    regDevWriteNumber(&high, 0x10, 0.0);
+    check("no merge with pending write", driver.masked && driver.reg[0] == 0x1a);
+    complete(&low, S_dev_success);
+    complete(&high, S_dev_success);
+    rval = 0;
+    check("shadow after merged writes",
+        regDevReadNumber(&readback, &rval, NULL) == S_dev_success && rval == 0x1a);
+
+    /* a failed write forgets the register */
+    regDevWriteNumber(&low, 0x05, 0.0);
+    complete(&low, S_dev_deviceTMO);
+    check("failed write unknown",
+        regDevReadNumber(&readback, &rval, NULL) != S_dev_success);
+    return errorcount;
+}
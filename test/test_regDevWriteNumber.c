@@ -23,12 +23,13 @@ int test_regDevWriteNumber()
     link.value.instio.string = malloc(80);
     strcpy(link.value.instio.string, "test/0 T=int8");
 
-    simRegDevConfigure ("test",100,0,0,0);
+    simRegDevConfigure ("test",100,0,0,0,0);
     priv = regDevAllocPriv(&record);
     assert(priv);
 
-    parsestatus = regDevIoParse(&record, &link);
+    parsestatus = regDevIoParse(&record, &link, TYPE_INT);
     assert(parsestatus==0);
+    priv = record.dpvt;
     printf ("low=%llx hight=%llx\n", priv->L, priv->H);
     for (i=-300; i<=300; i++)
     {